@@ -0,0 +1,514 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Generates a synthetic, TTNN-shaped corpus for benchmarking the checks.
+
+The corpus mirrors the layout the checks are written for:
+
+  include/ttnn/...                                   mock tensor/nanobind headers
+  ttnn/operations/<category>/<op>/device/
+      <op>_device_operation_types.hpp                operation_attributes_t,
+                                                     tensor_args_t, return aliases
+      <op>_device_operation.hpp / .cpp               DeviceOperation struct
+      <op>_program_factory.cpp                       uses tensor_return_value_t
+  ttnn/operations/<category>/<category>_nanobind.cpp bind_registered_operation calls
+  compile_commands.json
+
+The output is deterministic for a given set of arguments.
+"""
+
+import argparse
+import json
+import os
+import random
+
+CATEGORIES = [
+    "data_movement",
+    "eltwise",
+    "reduction",
+    "normalization",
+    "matmul",
+    "pool",
+    "transformer",
+    "ccl",
+]
+
+OP_STEMS = [
+    "slice", "concat", "pad", "tilize", "untilize", "permute", "transpose",
+    "softmax", "layernorm", "groupnorm", "argmax", "topk", "sum", "mean",
+    "gather", "scatter", "repeat", "fold", "upsample", "maxpool", "avgpool",
+    "all_gather", "reduce_scatter", "matmul", "linear", "embedding", "where",
+]
+
+ATTRIBUTE_MEMBERS = [
+    "ttnn::MemoryConfig output_mem_config;",
+    "std::vector<uint32_t> dims;",
+    "std::string mode;",
+    "uint32_t num_links = 1;",
+    "bool keepdim = false;",
+    "float scale = 1.0f;",
+    "std::optional<ttnn::DataType> output_dtype;",
+    "std::vector<int64_t> padding;",
+]
+
+
+def to_pascal_case(name):
+    return "".join(part[:1].upper() + part[1:] for part in name.split("_"))
+
+
+def write(path, text):
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def heavy_header(num_decls):
+    """Stands in for the large tt-metal include prefix every TU parses."""
+    lines = [
+        "#pragma once",
+        "#include <cstdint>",
+        "#include <functional>",
+        "#include <map>",
+        "#include <memory>",
+        "#include <optional>",
+        "#include <string>",
+        "#include <tuple>",
+        "#include <variant>",
+        "#include <vector>",
+        "",
+        "namespace tt::tt_metal::detail {",
+    ]
+    for i in range(num_decls):
+        lines += [
+            f"template <typename T, int N = {i % 7}>",
+            f"struct Detail{i} {{",
+            "    std::vector<T> values;",
+            f"    std::map<int, std::string> names;",
+            f"    T get(int k) const {{ return values.empty() ? T{{}} : values[k % values.size()]; }}",
+            "};",
+            f"inline int detail_fn_{i}(const Detail{i}<int>& d) {{ return d.get({i}) + {i}; }}",
+        ]
+    lines += ["}  // namespace tt::tt_metal::detail", ""]
+    return "\n".join(lines)
+
+
+TENSOR_HPP = """#pragma once
+#include "ttnn/metal_heavy.hpp"
+
+namespace tt {
+using KernelHandle = uint32_t;
+}
+
+namespace ttnn {
+
+enum class DataType { BFLOAT16, FLOAT32, UINT32 };
+
+struct MemoryConfig {
+    int layout = 0;
+};
+
+class TensorSpec {
+public:
+    std::vector<uint32_t> shape;
+};
+
+class Tensor {
+public:
+    Tensor() = default;
+    Tensor(const Tensor&) = default;
+    Tensor& operator=(const Tensor&) = default;
+    TensorSpec spec() const { return {}; }
+    uint32_t buffer_address() const { return 0; }
+
+private:
+    std::shared_ptr<int> storage_;
+};
+
+}  // namespace ttnn
+"""
+
+DEVICE_OPERATION_HPP = """#pragma once
+#include "ttnn/tensor.hpp"
+
+namespace tt::tt_metal {
+struct Program {};
+}  // namespace tt::tt_metal
+
+namespace ttnn::device_operation {
+
+template <typename shared_variables_t>
+struct CachedProgram {
+    tt::tt_metal::Program program;
+    shared_variables_t shared_variables;
+};
+
+}  // namespace ttnn::device_operation
+"""
+
+NANOBIND_HPP = """#pragma once
+#include "ttnn/tensor.hpp"
+
+namespace nb {
+struct module_ {};
+struct arg {
+    arg(const char*) {}
+    arg& noconvert() { return *this; }
+    template <typename T>
+    arg& operator=(T&&) { return *this; }
+};
+}  // namespace nb
+
+namespace ttnn {
+
+template <typename... py_args_t>
+struct nanobind_arguments_t {
+    std::tuple<py_args_t...> value;
+    nanobind_arguments_t(py_args_t... args) : value(std::forward_as_tuple(args...)) {}
+};
+
+template <typename function_t, typename... py_args_t>
+struct nanobind_overload_t {
+    function_t function;
+    nanobind_arguments_t<py_args_t...> args;
+    nanobind_overload_t(function_t function, py_args_t... args) : function{function}, args{args...} {}
+};
+
+template <typename registered_operation_t, typename... overload_t>
+void bind_registered_operation(
+    nb::module_& module, const registered_operation_t& operation, const std::string& doc, overload_t&&... overloads) {}
+
+}  // namespace ttnn
+"""
+
+
+def types_header(category, op, rng):
+    members = rng.sample(ATTRIBUTE_MEMBERS, rng.randint(2, len(ATTRIBUTE_MEMBERS)))
+    body = "\n".join("    " + m for m in members)
+    return f"""#pragma once
+#include "ttnn/tensor.hpp"
+
+namespace ttnn::operations::{category}::{op} {{
+
+struct operation_attributes_t {{
+{body}
+}};
+
+struct tensor_args_t {{
+    const Tensor& input;
+    std::optional<Tensor> optional_output_tensor;
+}};
+
+using spec_return_value_t = TensorSpec;
+using tensor_return_value_t = Tensor;
+
+}}  // namespace ttnn::operations::{category}::{op}
+"""
+
+
+def device_operation_header(category, op):
+    Op = to_pascal_case(op)
+    return f"""#pragma once
+#include "{op}_device_operation_types.hpp"
+#include "ttnn/device_operation.hpp"
+
+namespace ttnn::operations::{category}::{op} {{
+
+struct {Op}ProgramFactory {{
+    struct shared_variables_t {{
+        tt::KernelHandle reader_kernel_id;
+        tt::KernelHandle writer_kernel_id;
+    }};
+    using cached_program_t = ttnn::device_operation::CachedProgram<shared_variables_t>;
+
+    static cached_program_t create(
+        const operation_attributes_t& operation_attributes,
+        const tensor_args_t& tensor_args,
+        tensor_return_value_t& tensor_return_value);
+
+    static void override_runtime_arguments(
+        cached_program_t& cached_program,
+        const operation_attributes_t& operation_attributes,
+        const tensor_args_t& tensor_args,
+        tensor_return_value_t& tensor_return_value);
+}};
+
+struct {Op}DeviceOperation {{
+    using operation_attributes_t = {op}::operation_attributes_t;
+    using tensor_args_t = {op}::tensor_args_t;
+    using spec_return_value_t = {op}::spec_return_value_t;
+    using tensor_return_value_t = {op}::tensor_return_value_t;
+    using program_factory_t = std::variant<{Op}ProgramFactory>;
+
+    static program_factory_t select_program_factory(const operation_attributes_t&, const tensor_args_t&);
+    static void validate_on_program_cache_miss(const operation_attributes_t&, const tensor_args_t&);
+    static spec_return_value_t compute_output_specs(const operation_attributes_t&, const tensor_args_t&);
+    static tensor_return_value_t create_output_tensors(const operation_attributes_t&, const tensor_args_t&);
+    static std::tuple<operation_attributes_t, tensor_args_t> invoke(
+        const Tensor& input, const std::optional<MemoryConfig>& memory_config);
+}};
+
+}}  // namespace ttnn::operations::{category}::{op}
+"""
+
+
+def device_operation_source(category, op):
+    Op = to_pascal_case(op)
+    return f"""#include "{op}_device_operation.hpp"
+
+namespace ttnn::operations::{category}::{op} {{
+
+{Op}DeviceOperation::program_factory_t {Op}DeviceOperation::select_program_factory(
+    const operation_attributes_t&, const tensor_args_t&) {{
+    return {Op}ProgramFactory{{}};
+}}
+
+void {Op}DeviceOperation::validate_on_program_cache_miss(
+    const {op}::operation_attributes_t& attributes, const {op}::tensor_args_t& tensor_args) {{}}
+
+{op}::spec_return_value_t {Op}DeviceOperation::compute_output_specs(
+    const operation_attributes_t&, const tensor_args_t& tensor_args) {{
+    return tensor_args.input.spec();
+}}
+
+{op}::tensor_return_value_t {Op}DeviceOperation::create_output_tensors(
+    const operation_attributes_t& attributes, const tensor_args_t& tensor_args) {{
+    if (tensor_args.optional_output_tensor.has_value()) {{
+        return *tensor_args.optional_output_tensor;
+    }}
+    return tensor_args.input;
+}}
+
+std::tuple<{Op}DeviceOperation::operation_attributes_t, {Op}DeviceOperation::tensor_args_t>
+{Op}DeviceOperation::invoke(const Tensor& input, const std::optional<MemoryConfig>& memory_config) {{
+    return {{{op}::operation_attributes_t{{}}, {op}::tensor_args_t{{input, std::nullopt}}}};
+}}
+
+}}  // namespace ttnn::operations::{category}::{op}
+"""
+
+
+def program_factory_source(category, op):
+    Op = to_pascal_case(op)
+    return f"""#include "{op}_device_operation.hpp"
+
+namespace ttnn::operations::{category}::{op} {{
+
+{Op}ProgramFactory::cached_program_t {Op}ProgramFactory::create(
+    const {op}::operation_attributes_t& operation_attributes,
+    const {op}::tensor_args_t& tensor_args,
+    {op}::tensor_return_value_t& tensor_return_value) {{
+    tt::tt_metal::Program program{{}};
+    const {op}::spec_return_value_t spec = tensor_args.input.spec();
+    tt::KernelHandle reader = tensor_args.input.buffer_address();
+    tt::KernelHandle writer = tensor_return_value.buffer_address();
+    return {{std::move(program), {{reader, writer}}}};
+}}
+
+void {Op}ProgramFactory::override_runtime_arguments(
+    cached_program_t& cached_program,
+    const {op}::operation_attributes_t& operation_attributes,
+    const {op}::tensor_args_t& tensor_args,
+    {op}::tensor_return_value_t& tensor_return_value) {{
+    auto& shared = cached_program.shared_variables;
+    shared.reader_kernel_id = tensor_args.input.buffer_address();
+    shared.writer_kernel_id = tensor_return_value.buffer_address();
+}}
+
+}}  // namespace ttnn::operations::{category}::{op}
+"""
+
+
+def operation_header(category, op):
+    Op = to_pascal_case(op)
+    return f"""#pragma once
+#include "ttnn/tensor.hpp"
+
+namespace ttnn {{
+
+struct {Op}Operation {{
+    Tensor operator()(const Tensor& input, const std::optional<MemoryConfig>& memory_config) const {{ return input; }}
+    Tensor operator()(const Tensor& input, float scale) const {{ return input; }}
+}};
+inline constexpr {Op}Operation {op}{{}};
+
+}}  // namespace ttnn
+"""
+
+
+def binding(op, index, kind):
+    """One bind_registered_operation call.
+
+    kind is one of:
+      simple     single overload, plain forwarding lambda (diagnosed)
+      alias      like simple, but via `using OperationType = decltype(...)`
+      transform  single overload that transforms an argument (not diagnosed)
+      multi      two overloads (not diagnosed)
+    """
+    doc = f'"{op} binding {index}"'
+    if kind == "simple":
+        return f"""    ttnn::bind_registered_operation(
+        mod,
+        ttnn::{op},
+        {doc},
+        ttnn::nanobind_overload_t{{
+            [](const decltype(ttnn::{op})& self,
+               const ttnn::Tensor& input_tensor,
+               const std::optional<ttnn::MemoryConfig>& memory_config) {{
+                return self(input_tensor, memory_config);
+            }},
+            nb::arg("input_tensor").noconvert(),
+            nb::arg("memory_config") = std::nullopt}});
+"""
+    if kind == "alias":
+        return f"""    using OperationType = decltype(ttnn::{op});
+    ttnn::bind_registered_operation(
+        mod,
+        ttnn::{op},
+        {doc},
+        ttnn::nanobind_overload_t{{
+            [](const OperationType& self,
+               const ttnn::Tensor& input_tensor,
+               const std::optional<ttnn::MemoryConfig>& memory_config) {{
+                return self(input_tensor, memory_config);
+            }},
+            nb::arg("input_tensor").noconvert(),
+            nb::arg("memory_config") = std::nullopt}});
+"""
+    if kind == "transform":
+        return f"""    ttnn::bind_registered_operation(
+        mod,
+        ttnn::{op},
+        {doc},
+        ttnn::nanobind_overload_t{{
+            [](const decltype(ttnn::{op})& self, const ttnn::Tensor& input_tensor, double scale) {{
+                return self(input_tensor, static_cast<float>(scale));
+            }},
+            nb::arg("input_tensor").noconvert(),
+            nb::arg("scale") = 1.0}});
+"""
+    return f"""    ttnn::bind_registered_operation(
+        mod,
+        ttnn::{op},
+        {doc},
+        ttnn::nanobind_overload_t{{
+            [](const decltype(ttnn::{op})& self,
+               const ttnn::Tensor& input_tensor,
+               const std::optional<ttnn::MemoryConfig>& memory_config) {{
+                return self(input_tensor, memory_config);
+            }},
+            nb::arg("input_tensor").noconvert(),
+            nb::arg("memory_config") = std::nullopt}},
+        ttnn::nanobind_overload_t{{
+            [](const decltype(ttnn::{op})& self, const ttnn::Tensor& input_tensor, float scale) {{
+                return self(input_tensor, scale);
+            }},
+            nb::arg("input_tensor").noconvert(),
+            nb::arg("scale")}});
+"""
+
+
+def nanobind_source(category, ops, bindings_per_op, multi_ratio, rng):
+    includes = "\n".join(f'#include "ttnn/operations/{category}/{op}/{op}.hpp"' for op in ops)
+    functions = []
+    for op in ops:
+        calls = []
+        for i in range(bindings_per_op):
+            r = rng.random()
+            if r < multi_ratio:
+                kind = "multi"
+            elif r < multi_ratio + (1 - multi_ratio) * 0.2:
+                kind = "transform"
+            elif r < multi_ratio + (1 - multi_ratio) * 0.4:
+                kind = "alias"
+            else:
+                kind = "simple"
+            # Each alias binding gets its own scope so OperationType is unique
+            call = binding(op, i, kind)
+            calls.append("    {\n" + call + "    }\n" if kind == "alias" else call)
+        functions.append(f"void bind_{op}(nb::module_& mod) {{\n" + "".join(calls) + "}\n")
+    return f"""#include "ttnn/nanobind.hpp"
+{includes}
+
+namespace ttnn::operations::{category} {{
+
+{chr(10).join(functions)}
+}}  // namespace ttnn::operations::{category}
+"""
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--out", required=True, help="Output directory for the corpus")
+    parser.add_argument("--ops", type=int, default=200, help="Number of device operations to generate")
+    parser.add_argument(
+        "--bindings-per-op", type=int, default=10, help="bind_registered_operation calls generated per operation"
+    )
+    parser.add_argument(
+        "--multi-overload-ratio", type=float, default=0.3, help="Fraction of bindings with two nanobind_overload_t"
+    )
+    parser.add_argument(
+        "--header-decls",
+        type=int,
+        default=500,
+        help="Declarations in the shared heavy header (controls the header-to-source ratio)",
+    )
+    parser.add_argument("--seed", type=int, default=0, help="Random seed")
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    out = os.path.abspath(args.out)
+    include_dir = os.path.join(out, "include")
+
+    write(os.path.join(include_dir, "ttnn", "metal_heavy.hpp"), heavy_header(args.header_decls))
+    write(os.path.join(include_dir, "ttnn", "tensor.hpp"), TENSOR_HPP)
+    write(os.path.join(include_dir, "ttnn", "device_operation.hpp"), DEVICE_OPERATION_HPP)
+    write(os.path.join(include_dir, "ttnn", "nanobind.hpp"), NANOBIND_HPP)
+
+    ops_by_category = {c: [] for c in CATEGORIES}
+    sources = []
+    for i in range(args.ops):
+        category = CATEGORIES[i % len(CATEGORIES)]
+        op = f"{OP_STEMS[i % len(OP_STEMS)]}_{i}"
+        ops_by_category[category].append(op)
+
+        op_dir = os.path.join(out, "ttnn", "operations", category, op)
+        device_dir = os.path.join(op_dir, "device")
+        write(os.path.join(op_dir, f"{op}.hpp"), operation_header(category, op))
+        write(os.path.join(device_dir, f"{op}_device_operation_types.hpp"), types_header(category, op, rng))
+        write(os.path.join(device_dir, f"{op}_device_operation.hpp"), device_operation_header(category, op))
+
+        device_cpp = os.path.join(device_dir, f"{op}_device_operation.cpp")
+        factory_cpp = os.path.join(device_dir, f"{op}_program_factory.cpp")
+        write(device_cpp, device_operation_source(category, op))
+        write(factory_cpp, program_factory_source(category, op))
+        sources += [device_cpp, factory_cpp]
+
+    for category, ops in ops_by_category.items():
+        if not ops:
+            continue
+        nanobind_cpp = os.path.join(out, "ttnn", "operations", category, f"{category}_nanobind.cpp")
+        write(nanobind_cpp, nanobind_source(category, ops, args.bindings_per_op, args.multi_overload_ratio, rng))
+        sources.append(nanobind_cpp)
+
+    # The op headers are included as "ttnn/operations/<category>/<op>/<op>.hpp"
+    commands = [
+        {
+            "directory": out,
+            "arguments": ["clang++", "-std=c++20", f"-I{include_dir}", f"-I{out}", "-c", source],
+            "file": source,
+        }
+        for source in sources
+    ]
+    with open(os.path.join(out, "compile_commands.json"), "w") as f:
+        json.dump(commands, f, indent=2)
+
+    print(
+        f"Generated {len(sources)} TUs ({args.ops} operations, "
+        f"{args.ops * args.bindings_per_op} bind_registered_operation calls) in {out}"
+    )
+
+
+if __name__ == "__main__":
+    main()
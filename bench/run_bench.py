@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Runs each TTNN check over a corpus and records a JSON baseline.
+
+Every check is run on its own over every TU in the corpus's
+compile_commands.json with --enable-check-profile. For each check the
+baseline records:
+
+  profile      per-bucket wall/user/sys seconds summed over all TUs. clang-tidy
+               attributes matcher evaluation and the callback to the bucket of
+               the MatchCallback that registered the matcher, so shared
+               callbacks (e.g. ttnn-type-dispatch) appear as their own bucket.
+  wall_s       summed wall time of the clang-tidy processes
+  diagnostics  number of warnings emitted by the check
+  peak_rss_kb  largest peak RSS of any clang-tidy process
+
+With --combined, all checks are also run together in one clang-tidy process
+per TU and recorded under "combined". The sum of the per-check wall times is
+what loading one plugin per check would cost, so comparing the two measures
+what sharing the traversal and the semantic model saves.
+
+Pass --baseline to compare against a previous run.
+"""
+
+import argparse
+import concurrent.futures
+import glob
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+PROFILE_KEY = re.compile(r"^time\.clang-tidy\.(?P<bucket>.+)\.(?P<kind>wall|user|sys)$")
+
+
+def run_one(clang_tidy, plugin, checks, corpus, source, extra_args):
+    """Runs clang-tidy on one TU and returns (profile, diagnostics, rss_kb, wall_s, output)."""
+    profile_dir = tempfile.mkdtemp(prefix="ttnn-bench-")
+    try:
+        cmd = [
+            clang_tidy,
+            f"-load={plugin}",
+            f"-checks=-*,{','.join(checks)}",
+            "-p",
+            corpus,
+            "--quiet",
+            "--enable-check-profile",
+            f"--store-check-profile={profile_dir}",
+        ] + extra_args + [source]
+
+        start = time.perf_counter()
+        proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+        output = proc.stdout.read()
+        proc.stdout.close()
+        # wait4 instead of Popen.wait so we get the child's resource usage
+        _, status, usage = os.wait4(proc.pid, 0)
+        proc.returncode = os.waitstatus_to_exitcode(status)
+        wall = time.perf_counter() - start
+
+        profile = {}
+        for path in glob.glob(os.path.join(profile_dir, "*.json")):
+            with open(path) as f:
+                data = json.load(f)
+            for key, value in data.get("profile", {}).items():
+                m = PROFILE_KEY.match(key)
+                if not m:
+                    continue
+                bucket = profile.setdefault(m.group("bucket"), {"wall": 0.0, "user": 0.0, "sys": 0.0})
+                bucket[m.group("kind")] += value
+
+        names = "|".join(re.escape(check) for check in checks)
+        diagnostics = len(re.findall(r": warning: .*\[(?:" + names + r")\]", output))
+        return profile, diagnostics, usage.ru_maxrss, wall, output
+    finally:
+        shutil.rmtree(profile_dir, ignore_errors=True)
+
+
+def bench_check(args, checks, sources):
+    result = {"files": len(sources), "wall_s": 0.0, "diagnostics": 0, "peak_rss_kb": 0, "profile": {}}
+    with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        futures = [
+            pool.submit(run_one, args.clang_tidy, args.plugin, checks, args.corpus, source, args.extra_arg)
+            for source in sources
+        ]
+        for future in concurrent.futures.as_completed(futures):
+            profile, diagnostics, rss_kb, wall, output = future.result()
+            if args.verbose:
+                sys.stdout.write(output)
+            result["wall_s"] += wall
+            result["diagnostics"] += diagnostics
+            result["peak_rss_kb"] = max(result["peak_rss_kb"], rss_kb)
+            for name, times in profile.items():
+                bucket = result["profile"].setdefault(name, {"wall": 0.0, "user": 0.0, "sys": 0.0})
+                for kind, value in times.items():
+                    bucket[kind] += value
+    return result
+
+
+def print_result(data):
+    print(
+        f"  wall {data['wall_s']:.2f}s, {data['diagnostics']} diagnostics, "
+        f"peak RSS {data['peak_rss_kb'] / 1024:.1f} MiB"
+    )
+    for name, times in sorted(data["profile"].items()):
+        print(f"    {name:40} wall {times['wall']:.4f}s  user {times['user']:.4f}s  sys {times['sys']:.4f}s")
+
+
+def compare(current, baseline):
+    print("\nComparison against baseline:")
+    for check, data in current["checks"].items():
+        old = baseline.get("checks", {}).get(check)
+        if not old:
+            print(f"  {check}: no baseline")
+            continue
+        for field in ("wall_s", "diagnostics", "peak_rss_kb"):
+            before, after = old.get(field, 0), data[field]
+            delta = (after - before) / before * 100 if before else 0.0
+            print(f"  {check:40} {field:12} {before:>12.3f} -> {after:>12.3f} ({delta:+.1f}%)")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--clang-tidy", required=True, help="clang-tidy executable")
+    parser.add_argument("--plugin", required=True, help="Path to TtNNChecks.so")
+    parser.add_argument("--corpus", required=True, help="Corpus directory containing compile_commands.json")
+    parser.add_argument("--checks", required=True, help="Comma-separated list of checks to benchmark")
+    parser.add_argument("--output", required=True, help="Where to write the JSON results")
+    parser.add_argument("--baseline", help="Previous JSON results to compare against")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(), help="Parallel clang-tidy processes")
+    parser.add_argument(
+        "--extra-arg", action="append", default=[], help="Extra argument passed to clang-tidy (repeatable)"
+    )
+    parser.add_argument(
+        "--combined", action="store_true", help="Also run all checks in one process and compare with the separate runs"
+    )
+    parser.add_argument("--verbose", action="store_true", help="Print clang-tidy output")
+    args = parser.parse_args()
+
+    with open(os.path.join(args.corpus, "compile_commands.json")) as f:
+        sources = [entry["file"] for entry in json.load(f)]
+
+    version = subprocess.run([args.clang_tidy, "--version"], capture_output=True, text=True).stdout.strip()
+    results = {
+        "clang_tidy": version,
+        "plugin": os.path.abspath(args.plugin),
+        "corpus": os.path.abspath(args.corpus),
+        "jobs": args.jobs,
+        "checks": {},
+    }
+
+    checks = [check for check in args.checks.split(",") if check]
+    for check in checks:
+        print(f"Benchmarking {check} on {len(sources)} TUs...", flush=True)
+        data = bench_check(args, [check], sources)
+        results["checks"][check] = data
+        print_result(data)
+
+    if args.combined:
+        print(f"Benchmarking {len(checks)} checks together on {len(sources)} TUs...", flush=True)
+        data = bench_check(args, checks, sources)
+        results["combined"] = data
+        print_result(data)
+        separate = sum(results["checks"][check]["wall_s"] for check in checks)
+        saved = (separate - data["wall_s"]) / separate * 100 if separate else 0.0
+        print(f"  separate runs {separate:.2f}s, combined run {data['wall_s']:.2f}s ({saved:.1f}% saved)")
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+    with open(args.output, "w") as f:
+        json.dump(results, f, indent=2)
+    print(f"Wrote {args.output}")
+
+    if args.baseline and os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            compare(results, json.load(f))
+
+
+if __name__ == "__main__":
+    main()
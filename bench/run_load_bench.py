@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Compares the load time and matcher throughput of two TtNNChecks builds.
+
+Meant for an optimized plugin (TTNN_OPTIMIZED_BUILD, TTNN_PGO=use) against
+one from a default build of the same sources. For each plugin it records:
+
+  startup     wall seconds of `clang-tidy -load=<plugin> --list-checks`,
+              which loads the plugin and registers the module and its
+              checks without parsing anything. This is paid once per
+              clang-tidy process, so once per TU batch in ttnn-tidy. The
+              plugins are run alternately so that both see the same cache
+              and frequency state.
+  throughput  per check, the profiled matcher + callback wall time over the
+              corpus (as recorded by run_bench.py) and the TUs per second of
+              matcher time
+"""
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import run_bench  # noqa: E402
+
+
+def time_startup(clang_tidy, plugin):
+    """Returns the wall seconds of one --list-checks run and the checks it listed."""
+    cmd = [clang_tidy, f"-load={plugin}", "-checks=-*,ttnn-*", "--list-checks"]
+    start = time.perf_counter()
+    proc = subprocess.run(cmd, capture_output=True, text=True)
+    wall = time.perf_counter() - start
+    if proc.returncode != 0:
+        sys.exit(f"{' '.join(cmd)} failed:\n{proc.stderr}")
+    checks = sorted(line.strip() for line in proc.stdout.splitlines() if line.strip().startswith("ttnn-"))
+    return wall, checks
+
+
+def bench_startup(args, plugins):
+    times = {name: [] for name in plugins}
+    listed = {}
+    for run in range(args.warmup + args.runs):
+        # Alternate which plugin goes first so neither always runs on a warmer cache
+        order = list(plugins.items())
+        if run % 2:
+            order.reverse()
+        for name, plugin in order:
+            wall, checks = time_startup(args.clang_tidy, plugin)
+            listed[name] = checks
+            if run >= args.warmup:
+                times[name].append(wall)
+
+    if len({tuple(checks) for checks in listed.values()}) != 1:
+        sys.exit(f"The plugins register different checks: {listed}")
+
+    return {
+        name: {
+            "runs": len(samples),
+            "min_s": min(samples),
+            "median_s": statistics.median(samples),
+            "mean_s": statistics.fmean(samples),
+        }
+        for name, samples in times.items()
+    }
+
+
+def bench_throughput(args, plugin, sources):
+    bench_args = argparse.Namespace(
+        clang_tidy=args.clang_tidy,
+        plugin=plugin,
+        corpus=args.corpus,
+        jobs=args.jobs,
+        extra_arg=args.extra_arg,
+        verbose=False,
+    )
+    result = {}
+    for check in filter(None, args.checks.split(",")):
+        data = run_bench.bench_check(bench_args, check, sources)
+        matcher_s = sum(times["wall"] for times in data["profile"].values())
+        result[check] = {
+            "files": data["files"],
+            "matcher_wall_s": matcher_s,
+            "tus_per_s": data["files"] / matcher_s if matcher_s else 0.0,
+            "wall_s": data["wall_s"],
+            "diagnostics": data["diagnostics"],
+            "peak_rss_kb": data["peak_rss_kb"],
+        }
+    return result
+
+
+def report(results):
+    baseline, optimized = results["startup"]["baseline"], results["startup"]["optimized"]
+    delta = (optimized["median_s"] - baseline["median_s"]) / baseline["median_s"] * 100
+    print("\nStartup (-load + --list-checks), median of", baseline["runs"], "runs:")
+    print(f"  baseline  {baseline['median_s'] * 1000:10.2f} ms")
+    print(f"  optimized {optimized['median_s'] * 1000:10.2f} ms ({delta:+.1f}%)")
+
+    if "throughput" not in results:
+        return
+    print("\nMatcher throughput:")
+    for check, old in results["throughput"]["baseline"].items():
+        new = results["throughput"]["optimized"][check]
+        delta = (new["tus_per_s"] - old["tus_per_s"]) / old["tus_per_s"] * 100 if old["tus_per_s"] else 0.0
+        print(
+            f"  {check:40} {old['tus_per_s']:10.1f} -> {new['tus_per_s']:10.1f} TUs/s ({delta:+.1f}%)"
+        )
+        if new["diagnostics"] != old["diagnostics"]:
+            print(f"  {check:40} diagnostics differ: {old['diagnostics']} -> {new['diagnostics']}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--clang-tidy", required=True, help="clang-tidy executable")
+    parser.add_argument("--plugin", required=True, help="Optimized TtNNChecks.so")
+    parser.add_argument("--baseline-plugin", required=True, help="TtNNChecks.so from a default build")
+    parser.add_argument("--corpus", help="Corpus directory; without it only startup is measured")
+    parser.add_argument("--checks", default="", help="Comma-separated checks for the throughput runs")
+    parser.add_argument("--output", required=True, help="Where to write the JSON results")
+    parser.add_argument("--runs", type=int, default=30, help="Timed startup runs per plugin")
+    parser.add_argument("--warmup", type=int, default=3, help="Untimed startup runs per plugin")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(), help="Parallel clang-tidy processes")
+    parser.add_argument(
+        "--extra-arg", action="append", default=[], help="Extra argument passed to clang-tidy (repeatable)"
+    )
+    args = parser.parse_args()
+    if args.runs < 1:
+        parser.error("--runs must be at least 1")
+
+    plugins = {"baseline": args.baseline_plugin, "optimized": args.plugin}
+    results = {
+        "plugins": {name: os.path.abspath(plugin) for name, plugin in plugins.items()},
+        "plugin_bytes": {name: os.path.getsize(plugin) for name, plugin in plugins.items()},
+    }
+
+    print(f"Timing plugin startup over {args.runs} runs...", flush=True)
+    results["startup"] = bench_startup(args, plugins)
+
+    if args.corpus and args.checks:
+        with open(os.path.join(args.corpus, "compile_commands.json")) as f:
+            sources = [entry["file"] for entry in json.load(f)]
+        results["throughput"] = {}
+        for name, plugin in plugins.items():
+            print(f"Benchmarking {name} plugin matchers on {len(sources)} TUs...", flush=True)
+            results["throughput"][name] = bench_throughput(args, plugin, sources)
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+    with open(args.output, "w") as f:
+        json.dump(results, f, indent=2)
+    print(f"Wrote {args.output}")
+
+    report(results)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,85 @@
+# SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# Optimized build mode for the TTNN plugin. clang-tidy loads the plugin and
+# registers its checks once per process, and ttnn-tidy starts a process per
+# TU batch, so load time and code layout are paid on every TU.
+#
+#   TTNN_OPTIMIZED_BUILD  hidden visibility, LTO and section GC, and a Release
+#                         build when no build type is given
+#   TTNN_PGO              "generate" builds an instrumented plugin that the
+#                         bench-pgo-train target runs over the benchmark
+#                         corpus; "use" rebuilds it with that profile
+#   TTNN_PGO_DIR          where the training profile is written and read
+#
+# Defines ttnn_optimize_plugin(<target>) and, for the bench targets,
+# TTNN_PGO_RAW_DIR (where the instrumented plugin writes) and
+# TTNN_PGO_PROFDATA (Clang only, the merged profile).
+
+option(TTNN_OPTIMIZED_BUILD "Build the plugin with hidden visibility, LTO and section GC" OFF)
+set(TTNN_PGO "" CACHE STRING "Profile-guided optimization stage for the plugin: generate, use or empty")
+set_property(CACHE TTNN_PGO PROPERTY STRINGS "" generate use)
+set(TTNN_PGO_DIR "${CMAKE_BINARY_DIR}/pgo" CACHE PATH "Directory holding the plugin's PGO training profile")
+
+if(TTNN_PGO AND NOT TTNN_PGO MATCHES "^(generate|use)$")
+  message(FATAL_ERROR "TTNN_PGO must be 'generate', 'use' or empty, not '${TTNN_PGO}'")
+endif()
+
+# Without a build type the compiler runs at -O0, which no other flag here
+# makes up for
+if(TTNN_OPTIMIZED_BUILD AND NOT CMAKE_BUILD_TYPE AND NOT CMAKE_CONFIGURATION_TYPES)
+  set(CMAKE_BUILD_TYPE Release CACHE STRING "Build type" FORCE)
+endif()
+
+# Clang writes raw profiles that llvm-profdata merges; GCC writes .gcda files
+# that it reads back from the same directory
+set(TTNN_PGO_RAW_DIR "${TTNN_PGO_DIR}")
+set(TTNN_PGO_PROFDATA "")
+if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+  set(TTNN_PGO_RAW_DIR "${TTNN_PGO_DIR}/raw")
+  set(TTNN_PGO_PROFDATA "${TTNN_PGO_DIR}/TtNNChecks.profdata")
+endif()
+
+function(ttnn_optimize_plugin target)
+  if(TTNN_OPTIMIZED_BUILD)
+    # Only the registry entry has to be reachable from clang-tidy, and that is
+    # done by the static initializer, not by symbol lookup
+    set_target_properties(${target} PROPERTIES
+      CXX_VISIBILITY_PRESET hidden
+      VISIBILITY_INLINES_HIDDEN ON
+    )
+
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT TTNN_IPO_SUPPORTED OUTPUT TTNN_IPO_ERROR LANGUAGES CXX)
+    if(TTNN_IPO_SUPPORTED)
+      set_target_properties(${target} PROPERTIES INTERPROCEDURAL_OPTIMIZATION ON)
+    else()
+      message(WARNING "LTO is not supported by this toolchain: ${TTNN_IPO_ERROR}")
+    endif()
+
+    target_compile_options(${target} PRIVATE -ffunction-sections -fdata-sections)
+    target_link_options(${target} PRIVATE -Wl,--gc-sections -Wl,--as-needed)
+  endif()
+
+  if(TTNN_PGO STREQUAL "generate")
+    file(MAKE_DIRECTORY "${TTNN_PGO_RAW_DIR}")
+    target_compile_options(${target} PRIVATE "-fprofile-generate=${TTNN_PGO_RAW_DIR}")
+    target_link_options(${target} PRIVATE "-fprofile-generate=${TTNN_PGO_RAW_DIR}")
+  elseif(TTNN_PGO STREQUAL "use")
+    if(TTNN_PGO_PROFDATA)
+      if(NOT EXISTS "${TTNN_PGO_PROFDATA}")
+        message(FATAL_ERROR "PGO profile ${TTNN_PGO_PROFDATA} not found.\n"
+          "  Build with -DTTNN_PGO=generate and run the bench-pgo-train target first")
+      endif()
+      target_compile_options(${target} PRIVATE "-fprofile-use=${TTNN_PGO_PROFDATA}")
+      target_link_options(${target} PRIVATE "-fprofile-use=${TTNN_PGO_PROFDATA}")
+    else()
+      # The corpus does not reach every function, so cold ones keep their
+      # normal optimization instead of being optimized for size
+      target_compile_options(${target} PRIVATE
+        "-fprofile-use=${TTNN_PGO_DIR}" -fprofile-partial-training -Wno-missing-profile)
+      target_link_options(${target} PRIVATE "-fprofile-use=${TTNN_PGO_DIR}")
+    endif()
+  endif()
+endfunction()
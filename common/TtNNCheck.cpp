@@ -0,0 +1,328 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNCheck.h"
+#include "TtNNNames.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/Decl.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <vector>
+
+using namespace clang::ast_matchers;
+
+namespace clang::tidy {
+
+llvm::ArrayRef<std::pair<ttnn::TtNNTraversalScope, StringRef>>
+OptionEnumMapping<ttnn::TtNNTraversalScope>::getEnumMapping() {
+  static constexpr std::pair<ttnn::TtNNTraversalScope, StringRef> Mapping[] = {
+      {ttnn::TtNNTraversalScope::TranslationUnit, "TranslationUnit"},
+      {ttnn::TtNNTraversalScope::MainFile, "MainFile"},
+      {ttnn::TtNNTraversalScope::MainFileAndTypes, "MainFileAndTypes"},
+  };
+  return {Mapping};
+}
+
+namespace ttnn {
+
+bool isPairedTypesHeader(FileID FID, const SourceManager &SM) {
+  llvm::StringRef Filename = SM.getFilename(SM.getLocForStartOfFile(FID));
+  if (!isTypesFile(Filename)) {
+    return false;
+  }
+  llvm::StringRef MainFilename =
+      SM.getFilename(SM.getLocForStartOfFile(SM.getMainFileID()));
+  return llvm::sys::path::parent_path(Filename) ==
+         llvm::sys::path::parent_path(MainFilename);
+}
+
+bool isInAnalyzedFile(SourceLocation Loc, const SourceManager &SM,
+                      TtNNTraversalScope Scope) {
+  Loc = SM.getExpansionLoc(Loc);
+  if (Loc.isInvalid()) {
+    return false;
+  }
+  FileID FID = SM.getFileID(Loc);
+  if (FID == SM.getMainFileID()) {
+    return true;
+  }
+  return Scope == TtNNTraversalScope::MainFileAndTypes &&
+         isPairedTypesHeader(FID, SM);
+}
+
+std::string getRealPath(FileID FID, const SourceManager &SM) {
+  const FileEntry *Entry = SM.getFileEntryForID(FID);
+  if (!Entry) {
+    return "";
+  }
+  llvm::SmallString<256> Path(Entry->tryGetRealPathName());
+  if (Path.empty()) {
+    Path = SM.getFilename(SM.getLocForStartOfFile(FID));
+    llvm::sys::fs::make_absolute(Path);
+  }
+  return std::string(Path);
+}
+
+void restrictTraversalScope(ASTContext &Context, TtNNTraversalScope Scope) {
+  if (Scope == TtNNTraversalScope::TranslationUnit) {
+    return;
+  }
+
+  // Another check (or another run of this one) got here first
+  std::vector<Decl *> Current = Context.getTraversalScope();
+  if (Current.size() != 1 || !isa<TranslationUnitDecl>(Current.front())) {
+    return;
+  }
+
+  const SourceManager &SM = Context.getSourceManager();
+  FileID MainFID = SM.getMainFileID();
+  llvm::DenseMap<FileID, bool> Analyzed;
+
+  std::vector<Decl *> TopLevelDecls;
+  for (Decl *D : Context.getTranslationUnitDecl()->decls()) {
+    SourceLocation Loc = SM.getExpansionLoc(D->getLocation());
+    if (Loc.isInvalid()) {
+      continue;
+    }
+    FileID FID = SM.getFileID(Loc);
+    if (FID != MainFID) {
+      if (Scope != TtNNTraversalScope::MainFileAndTypes) {
+        continue;
+      }
+      auto [It, Inserted] = Analyzed.try_emplace(FID, false);
+      if (Inserted) {
+        It->second = isPairedTypesHeader(FID, SM);
+      }
+      if (!It->second) {
+        continue;
+      }
+    }
+    TopLevelDecls.push_back(D);
+  }
+
+  Context.setTraversalScope(TopLevelDecls);
+}
+
+TtNNCheck::TtNNCheck(StringRef Name, ClangTidyContext *Context,
+                     bool CachesHeaders)
+    : ClangTidyCheck(Name, Context),
+      Scope(Options.getLocalOrGlobal("TraversalScope",
+                                     TtNNTraversalScope::TranslationUnit)),
+      HeaderCacheDirectory(
+          Options.getLocalOrGlobal("HeaderCacheDirectory", "")),
+      StatisticsDirectory(
+          Options.getLocalOrGlobal("StatisticsDirectory", "")),
+      SpelledInSourceOnly(
+          Options.getLocalOrGlobal("SpelledInSourceOnly", false)),
+      CategoryNamespaces(Options.getLocalOrGlobal(
+          "CategoryNamespaces", kDefaultCategoryNamespaces)),
+      HeaderDiagnostics(Name.str(),
+                        CachesHeaders ? HeaderCacheDirectory : std::string()) {
+  if (!StatisticsDirectory.empty()) {
+    Statistics = std::make_unique<TtNNCheckStatistics>(Name.str(),
+                                                       StatisticsDirectory);
+  }
+  // Checks are created once the options of the main file are known
+  const std::optional<std::string> &Filter =
+      Context->getOptions().HeaderFilterRegex;
+  if (Filter && !Filter->empty()) {
+    HeaderFilter.emplace(*Filter);
+  }
+}
+
+void TtNNCheck::storeOptions(ClangTidyOptions::OptionMap &Opts) {
+  Options.store(Opts, "TraversalScope", Scope);
+  Options.store(Opts, "HeaderCacheDirectory", HeaderCacheDirectory);
+  Options.store(Opts, "StatisticsDirectory", StatisticsDirectory);
+  Options.store(Opts, "SpelledInSourceOnly", SpelledInSourceOnly);
+  Options.store(Opts, "CategoryNamespaces", CategoryNamespaces);
+}
+
+std::optional<TraversalKind> TtNNCheck::getCheckTraversalKind() const {
+  if (SpelledInSourceOnly) {
+    return TK_IgnoreUnlessSpelledInSource;
+  }
+  return std::nullopt;
+}
+
+void TtNNCheck::attachModel(MatchFinder *Finder) {
+  Model = TtNNSemanticModel::attach(Finder, CategoryNamespaces);
+}
+
+void TtNNCheck::registerSharedMatchers(MatchFinder *Finder) {
+  DependencyRecorder = TtNNDependencyRecorder::attach(Finder);
+  attachModel(Finder);
+  if (Scope == TtNNTraversalScope::TranslationUnit && !Statistics) {
+    return;
+  }
+  // The translation unit is matched before its children are traversed, which
+  // is the last point where the traversal scope can still be changed. It is
+  // also where the statistics learn which file they are about.
+  Finder->addMatcher(translationUnitDecl().bind("ttnn_translation_unit"), this);
+}
+
+bool TtNNCheck::handleTraversalScope(const MatchFinder::MatchResult &Result) {
+  if (!Result.Nodes.getNodeAs<TranslationUnitDecl>("ttnn_translation_unit")) {
+    return false;
+  }
+  if (Statistics) {
+    const SourceManager &SM = *Result.SourceManager;
+    Statistics->setMainFile(getRealPath(SM.getMainFileID(), SM));
+  }
+  if (Scope == TtNNTraversalScope::TranslationUnit) {
+    return true;
+  }
+  restrictTraversalScope(*Result.Context, Scope);
+  if (HeaderDiagnostics.isEnabled()) {
+    prepareHeaderCache(*Result.Context);
+  }
+  return true;
+}
+
+std::string TtNNCheck::getOptionsFingerprint() {
+  if (OptionsFingerprint) {
+    return *OptionsFingerprint;
+  }
+  ClangTidyOptions::OptionMap Opts;
+  storeOptions(Opts);
+
+  // Where the cache and the statistics live does not change what is in the
+  // cache
+  std::vector<std::string> Entries;
+  for (const auto &Opt : Opts) {
+    if (!Opt.getKey().ends_with(".HeaderCacheDirectory") &&
+        !Opt.getKey().ends_with(".StatisticsDirectory")) {
+      Entries.push_back((Opt.getKey() + "=" + Opt.getValue().Value).str());
+    }
+  }
+  llvm::sort(Entries);
+  OptionsFingerprint = llvm::join(Entries, "\n");
+  return *OptionsFingerprint;
+}
+
+void TtNNCheck::prepareHeaderCache(ASTContext &Context) {
+  // The traversal scope has just been restricted, so the headers in it are
+  // exactly the ones this check analyzes
+  const SourceManager &SM = Context.getSourceManager();
+  for (Decl *D : Context.getTraversalScope()) {
+    SourceLocation Loc = SM.getExpansionLoc(D->getLocation());
+    if (Loc.isValid()) {
+      prepareCachedHeader(SM.getFileID(Loc), SM);
+    }
+  }
+}
+
+void TtNNCheck::prepareCachedHeader(FileID FID, const SourceManager &SM) {
+  if (!HeaderDiagnostics.isEnabled()) {
+    return;
+  }
+  const std::vector<CachedDiagnostic> *Cached =
+      HeaderDiagnostics.prepare(FID, SM, getOptionsFingerprint());
+  if (!Cached) {
+    return;
+  }
+
+  SourceLocation Start = SM.getLocForStartOfFile(FID);
+  for (const CachedDiagnostic &Diagnostic : *Cached) {
+    auto Diag = diag(Start.getLocWithOffset(Diagnostic.Offset), "%0")
+                << Diagnostic.Message;
+    for (const CachedFixIt &FixIt : Diagnostic.FixIts) {
+      SourceLocation Begin = Start.getLocWithOffset(FixIt.Offset);
+      Diag << FixItHint::CreateReplacement(
+          CharSourceRange::getCharRange(Begin,
+                                        Begin.getLocWithOffset(FixIt.Length)),
+          FixIt.Text);
+    }
+  }
+}
+
+bool TtNNCheck::isReplayedFromCache(SourceLocation Loc,
+                                    const SourceManager &SM) const {
+  return HeaderDiagnostics.isReplayed(Loc, SM);
+}
+
+bool TtNNCheck::isInReportedFile(SourceLocation Loc,
+                                 const SourceManager &SM) {
+  Loc = SM.getExpansionLoc(Loc);
+  if (Loc.isInvalid()) {
+    return false;
+  }
+  if (isInAnalyzedFile(Loc, SM, Scope)) {
+    return true;
+  }
+
+  FileID FID = SM.getFileID(Loc);
+  auto [It, Inserted] = ReportedHeaders.try_emplace(FID, false);
+  if (Inserted) {
+    // The same test clang-tidy applies before it emits a header diagnostic
+    It->second =
+        HeaderFilter && !SM.isInSystemHeader(Loc) &&
+        HeaderFilter->match(SM.getFilename(SM.getLocForStartOfFile(FID)));
+    if (It->second) {
+      prepareCachedHeader(FID, SM);
+    }
+  }
+  return It->second;
+}
+
+void TtNNCheck::report(SourceLocation Loc, StringRef Message,
+                       ArrayRef<StringRef> Args, ArrayRef<FixItHint> FixIts,
+                       const SourceManager &SM) {
+  // Template instantiations and repeated matches of the same node report the
+  // same diagnostic again; only the first one is kept
+  llvm::SmallString<128> Key;
+  llvm::raw_svector_ostream KeyStream(Key);
+  KeyStream << Loc.getRawEncoding() << '\0' << Message;
+  for (StringRef Arg : Args) {
+    KeyStream << '\0' << Arg;
+  }
+  for (const FixItHint &Hint : FixIts) {
+    KeyStream << '\0' << Hint.RemoveRange.getBegin().getRawEncoding() << ' '
+              << Hint.RemoveRange.getEnd().getRawEncoding() << ' '
+              << Hint.RemoveRange.isTokenRange() << ' ' << Hint.CodeToInsert;
+  }
+  if (!Reported.insert(Key).second) {
+    countStage("report.duplicate");
+    return;
+  }
+
+  if (!HeaderDiagnostics.record(Loc, Message, Args, FixIts, SM,
+                                getLangOpts())) {
+    return;
+  }
+
+  auto Diag = diag(Loc, Message);
+  for (StringRef Arg : Args) {
+    Diag << Arg;
+  }
+  for (const FixItHint &Hint : FixIts) {
+    Diag << Hint;
+  }
+}
+
+void TtNNCheck::onEndOfTranslationUnit() {
+  if (llvm::Error Err = HeaderDiagnostics.flush()) {
+    configurationDiag("cannot write header diagnostics cache entry: %0")
+        << llvm::toString(std::move(Err));
+  }
+  ReportedHeaders.clear();
+  Reported.clear();
+
+  if (Statistics) {
+    if (llvm::Error Err = Statistics->flush()) {
+      configurationDiag("cannot write check statistics: %0")
+          << llvm::toString(std::move(Err));
+    }
+  }
+}
+
+} // namespace ttnn
+} // namespace clang::tidy
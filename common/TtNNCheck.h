@@ -0,0 +1,196 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNCHECK_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNCHECK_H_
+
+#include "clang-tidy/ClangTidyCheck.h"
+#include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/SourceManager.h"
+#include "common/TtNNDependencyRecorder.h"
+#include "common/TtNNHeaderDiagnostics.h"
+#include "common/TtNNSemanticModel.h"
+#include "common/TtNNStatistics.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/Regex.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+/// Which top-level declarations the AST matchers walk.
+enum class TtNNTraversalScope {
+  /// The whole translation unit, including every included header (default).
+  TranslationUnit,
+  /// Only top-level declarations spelled in the main file.
+  MainFile,
+  /// The main file plus the `*_device_operation_types.hpp` header next to it.
+  MainFileAndTypes,
+};
+
+/// Returns true if \p FID is a `*_device_operation_types.hpp` header in the
+/// same directory as the main file.
+bool isPairedTypesHeader(FileID FID, const SourceManager &SM);
+
+/// Returns true if \p Loc (after macro expansion) is in a file analyzed under
+/// \p Scope. For `TranslationUnit` only the main file counts, matching what
+/// the checks report on.
+bool isInAnalyzedFile(SourceLocation Loc, const SourceManager &SM,
+                      TtNNTraversalScope Scope);
+
+/// Returns the absolute path of \p FID, resolved through symlinks where clang
+/// did so, or an empty string if it is not a file.
+std::string getRealPath(FileID FID, const SourceManager &SM);
+
+/// Limits \p Context's traversal scope to the top-level declarations in the
+/// files analyzed under \p Scope. Does nothing for `TranslationUnit` or if
+/// the scope has already been restricted.
+void restrictTraversalScope(ASTContext &Context, TtNNTraversalScope Scope);
+
+/// Matches nodes whose expansion location is in a file analyzed under
+/// \p Scope (see isInAnalyzedFile).
+AST_POLYMORPHIC_MATCHER_P(isExpansionInAnalyzedFile,
+                          AST_POLYMORPHIC_SUPPORTED_TYPES(Decl, Stmt, TypeLoc),
+                          TtNNTraversalScope, Scope) {
+  return isInAnalyzedFile(Node.getBeginLoc(),
+                          Finder->getASTContext().getSourceManager(), Scope);
+}
+
+/// Base class for the TTNN checks.
+///
+/// Reads the options every TTNN check shares, documented in the README, and
+/// composes the per-translation-unit components they configure: the header
+/// cache entries (TtNNHeaderDiagnostics), the statistics
+/// (TtNNCheckStatistics), the dependency recorder of `ttnn-tidy`'s result
+/// cache (TtNNDependencyRecorder) and the semantic model (TtNNSemanticModel).
+/// The check itself applies the traversal scope, before any children of the
+/// translation unit are visited, and reports through report().
+class TtNNCheck : public ClangTidyCheck {
+public:
+  /// \p CachesHeaders is false for checks whose diagnostics in a header
+  /// depend on other files, which the header cache does not key on; they
+  /// ignore `HeaderCacheDirectory`.
+  TtNNCheck(StringRef Name, ClangTidyContext *Context,
+            bool CachesHeaders = true);
+  void storeOptions(ClangTidyOptions::OptionMap &Opts) override;
+  void onEndOfTranslationUnit() override;
+  std::optional<TraversalKind> getCheckTraversalKind() const override;
+
+protected:
+  /// Registers the matchers every TTNN check shares: the translation unit
+  /// matcher if the traversal scope or statistics options need it, the
+  /// semantic model, and the dependency recorder when run
+  /// by `ttnn-tidy` with a result cache. Call from registerMatchers().
+  void registerSharedMatchers(ast_matchers::MatchFinder *Finder);
+
+  /// Attaches the semantic model alone, for checks that do not call
+  /// registerSharedMatchers().
+  void attachModel(ast_matchers::MatchFinder *Finder);
+
+  /// The per-translation unit model shared by the TTNN checks. Only valid
+  /// in callbacks, after registerSharedMatchers() or attachModel().
+  TtNNSemanticModel &getModel() const { return *Model; }
+
+  /// Handles a match of the traversal scope matcher. Returns true if
+  /// \p Result was such a match, in which case check() should return.
+  bool handleTraversalScope(const ast_matchers::MatchFinder::MatchResult &Result);
+
+  TtNNTraversalScope getTraversalScope() const { return Scope; }
+
+  /// Pass to TtNNTypeLocDispatcher::subscribe().
+  bool isSpelledInSourceOnly() const { return SpelledInSourceOnly; }
+
+  /// Counts one pass through the filter stage \p Stage, e.g.
+  /// `type_loc.in_types_file` for a type location dropped because it is in a
+  /// types header. \p Stage must be a string literal or otherwise outlive
+  /// the translation unit.
+  void countStage(StringRef Stage) {
+    if (Statistics) {
+      Statistics->count(Stage);
+    }
+  }
+
+  /// Returns a timer that adds the time until it goes out of scope to the
+  /// path \p Path, e.g. `fix.rename_struct`.
+  TtNNStatisticsTimer timePath(StringRef Path) {
+    return TtNNStatisticsTimer(Statistics.get(), Path);
+  }
+
+  /// Reports \p Message at \p Loc with \p FixIts, substituting \p Args for
+  /// `%0`, `%1`, ... Diagnostics in headers are recorded for the header cache,
+  /// so checks must report header diagnostics through here rather than diag().
+  /// A diagnostic already reported in the translation unit with the same
+  /// location, text and fixes is dropped.
+  void report(SourceLocation Loc, StringRef Message, ArrayRef<StringRef> Args,
+              ArrayRef<FixItHint> FixIts, const SourceManager &SM);
+
+  /// As above, with the fix if there is one.
+  void report(SourceLocation Loc, StringRef Message, ArrayRef<StringRef> Args,
+              const std::optional<FixItHint> &FixIt, const SourceManager &SM) {
+    report(Loc, Message, Args,
+           FixIt ? ArrayRef<FixItHint>(*FixIt) : ArrayRef<FixItHint>(), SM);
+  }
+
+  /// Returns true if \p Loc is in a header whose diagnostics were replayed
+  /// from the header cache. Checks should skip such nodes.
+  bool isReplayedFromCache(SourceLocation Loc, const SourceManager &SM) const;
+
+  /// Returns true if the check reports on a declaration at \p Loc, after
+  /// macro expansion: it is in a file analyzed under the traversal scope, or
+  /// in a header outside the system directories that clang-tidy's
+  /// `-header-filter` admits. For checks that take their declarations from
+  /// the semantic model, whose index is not limited to the traversal scope.
+  /// A header admitted here joins the header cache, so call this before
+  /// isReplayedFromCache().
+  bool isInReportedFile(SourceLocation Loc, const SourceManager &SM);
+
+private:
+  void prepareHeaderCache(ASTContext &Context);
+  void prepareCachedHeader(FileID FID, const SourceManager &SM);
+  std::string getOptionsFingerprint();
+
+  const TtNNTraversalScope Scope;
+  const std::string HeaderCacheDirectory;
+  const std::string StatisticsDirectory;
+  const bool SpelledInSourceOnly;
+  const std::string CategoryNamespaces;
+
+  // clang-tidy's -header-filter, unset when it admits no header
+  std::optional<llvm::Regex> HeaderFilter;
+  std::optional<std::string> OptionsFingerprint;
+
+  // Null unless StatisticsDirectory is set
+  std::unique_ptr<TtNNCheckStatistics> Statistics;
+
+  std::shared_ptr<TtNNDependencyRecorder> DependencyRecorder;
+  std::shared_ptr<TtNNSemanticModel> Model;
+
+  // Headers analyzed in the current translation unit
+  TtNNHeaderDiagnostics HeaderDiagnostics;
+
+  // Headers outside the traversal scope and whether -header-filter admits
+  // them, see isInReportedFile()
+  llvm::DenseMap<FileID, bool> ReportedHeaders;
+
+  // Diagnostics reported in the current translation unit, see report()
+  llvm::StringSet<> Reported;
+};
+
+} // namespace clang::tidy::ttnn
+
+namespace clang::tidy {
+
+template <> struct OptionEnumMapping<ttnn::TtNNTraversalScope> {
+  static llvm::ArrayRef<std::pair<ttnn::TtNNTraversalScope, StringRef>>
+  getEnumMapping();
+};
+
+} // namespace clang::tidy
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNCHECK_H_
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNDependencyRecorder.h"
+#include "TtNNFinderShared.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+#include <optional>
+
+using namespace clang::ast_matchers;
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+std::optional<uint64_t> hashContent(const SrcMgr::ContentCache &Content,
+                                    StringRef Path) {
+  // Prefer the buffer that was parsed over what is on disk now
+  if (std::optional<llvm::MemoryBufferRef> Buffer =
+          Content.getBufferIfLoaded()) {
+    return llvm::xxHash64(Buffer->getBuffer());
+  }
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> File =
+      llvm::MemoryBuffer::getFile(Path);
+  if (!File) {
+    return std::nullopt;
+  }
+  return llvm::xxHash64((*File)->getBuffer());
+}
+
+} // namespace
+
+std::shared_ptr<TtNNDependencyRecorder>
+TtNNDependencyRecorder::attach(MatchFinder *Finder) {
+  std::optional<std::string> Directory =
+      llvm::sys::Process::GetEnv(kDependencyDirectoryEnv);
+  if (!Directory || Directory->empty()) {
+    return nullptr;
+  }
+
+  auto Create = [&] {
+    auto Recorder = std::make_shared<TtNNDependencyRecorder>();
+    Recorder->Directory = *Directory;
+    Finder->addMatcher(translationUnitDecl().bind("ttnn_dependency_unit"),
+                       Recorder.get());
+    return Recorder;
+  };
+
+  // One recorder per MatchFinder (i.e. per translation unit), as for the
+  // type dispatcher
+  return getFinderShared<TtNNDependencyRecorder>(Finder, *Directory, Create);
+}
+
+void TtNNDependencyRecorder::run(const MatchFinder::MatchResult &Result) {
+  if (Result.Nodes.getNodeAs<TranslationUnitDecl>("ttnn_dependency_unit")) {
+    SM = Result.SourceManager;
+  }
+}
+
+void TtNNDependencyRecorder::onEndOfTranslationUnit() {
+  if (!SM) {
+    return;
+  }
+  const SourceManager &Sources = *SM;
+  SM = nullptr;
+
+  FileID MainFID = Sources.getMainFileID();
+  StringRef MainFile =
+      Sources.getFilename(Sources.getLocForStartOfFile(MainFID));
+  if (MainFile.empty()) {
+    return;
+  }
+
+  std::string Content = "ttnn-tidy-deps 1\n";
+  llvm::StringSet<> Seen;
+  // Local entries are exactly the files entered while parsing this TU;
+  // headers loaded from a PCH are tracked by ttnn-tidy, which built it
+  for (unsigned I = 0, E = Sources.local_sloc_entry_size(); I != E; ++I) {
+    const SrcMgr::SLocEntry &Entry = Sources.getLocalSLocEntry(I);
+    if (!Entry.isFile()) {
+      continue;
+    }
+    const FileEntry *File = Sources.getFileEntryForSLocEntry(Entry);
+    if (!File) {
+      continue; // built-in or command line buffers
+    }
+
+    llvm::SmallString<256> Path(File->tryGetRealPathName());
+    if (Path.empty()) {
+      Path = Entry.getFile().getName();
+      llvm::sys::fs::make_absolute(Path);
+    }
+    if (!Seen.insert(Path).second) {
+      continue;
+    }
+
+    std::optional<uint64_t> Hash =
+        hashContent(Entry.getFile().getContentCache(), Path);
+    if (!Hash) {
+      return; // an incomplete list must not be written at all
+    }
+    Content += llvm::utohexstr(*Hash) + " " + std::string(Path) + "\n";
+  }
+
+  llvm::SmallString<256> Target(Directory);
+  llvm::sys::path::append(Target,
+                          llvm::utohexstr(llvm::xxHash64(MainFile)) + ".deps");
+
+  // Written to a unique file and renamed, so readers never see a partial list
+  llvm::SmallString<256> TempPath;
+  int FD;
+  if (llvm::sys::fs::createUniqueFile(llvm::Twine(Target) + "-%%%%%%%%.tmp",
+                                      FD, TempPath)) {
+    return;
+  }
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << Content;
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return;
+    }
+  }
+  if (llvm::sys::fs::rename(TempPath, Target)) {
+    llvm::sys::fs::remove(TempPath);
+  }
+}
+
+StringRef TtNNDependencyRecorder::getID() const {
+  return "ttnn-dependency-recorder";
+}
+
+} // namespace clang::tidy::ttnn
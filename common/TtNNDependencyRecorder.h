@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNDEPENDENCYRECORDER_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNDEPENDENCYRECORDER_H_
+
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+
+#include <memory>
+#include <string>
+
+namespace clang::tidy::ttnn {
+
+/// Environment variable through which `ttnn-tidy` asks the plugin to record
+/// the files each translation unit read.
+constexpr const char *kDependencyDirectoryEnv = "TTNN_TIDY_DEPENDENCY_DIR";
+
+/// Records every file a translation unit entered, with a hash of the content
+/// that was parsed, so `ttnn-tidy` can tell exactly when a stored result goes
+/// stale.
+///
+/// The list is written at the end of the translation unit to
+/// `<dir>/<hash of the main file path>.deps`:
+///
+///   ttnn-tidy-deps 1
+///   <xxhash64 hex> <absolute path>
+///   ...
+///
+/// Like `TtNNTypeLocDispatcher`, there is one recorder per `MatchFinder`,
+/// shared by every TTNN check in the run.
+class TtNNDependencyRecorder
+    : public ast_matchers::MatchFinder::MatchCallback {
+public:
+  /// Attaches the recorder for \p Finder, creating it if needed. Returns
+  /// nullptr unless `ttnn-tidy` enabled recording. The returned pointer keeps
+  /// the recorder alive and must be held for as long as \p Finder may run.
+  static std::shared_ptr<TtNNDependencyRecorder>
+  attach(ast_matchers::MatchFinder *Finder);
+
+  void run(const ast_matchers::MatchFinder::MatchResult &Result) override;
+  void onEndOfTranslationUnit() override;
+  StringRef getID() const override;
+
+private:
+  std::string Directory;
+  const SourceManager *SM = nullptr;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNDEPENDENCYRECORDER_H_
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNFINDERSHARED_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNFINDERSHARED_H_
+
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "llvm/ADT/STLExtras.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+/// Returns the object of type \p T that the checks registered on \p Finder
+/// share under \p Key, and creates it with \p Create for the first check.
+///
+/// clang-tidy creates a MatchFinder per translation unit and registers all
+/// enabled checks on it one after another, on one thread, before matching
+/// starts. So remembering the objects handed out for the last finder is
+/// enough: no lock and no process-wide map. The slot holds weak references,
+/// so the objects live exactly as long as the checks that hold them.
+template <typename T, typename KeyT, typename CreateT>
+std::shared_ptr<T> getFinderShared(const ast_matchers::MatchFinder *Finder,
+                                   const KeyT &Key, CreateT Create) {
+  struct Slot {
+    const ast_matchers::MatchFinder *Finder = nullptr;
+    std::vector<std::pair<KeyT, std::weak_ptr<T>>> Entries;
+  };
+  thread_local Slot Current;
+
+  if (Current.Finder != Finder) {
+    Current.Finder = Finder;
+    Current.Entries.clear();
+  }
+  for (const auto &[EntryKey, Entry] : Current.Entries) {
+    if (EntryKey == Key) {
+      // An expired entry means the finder address was reused by a new unit
+      if (std::shared_ptr<T> Shared = Entry.lock()) {
+        return Shared;
+      }
+    }
+  }
+
+  llvm::erase_if(Current.Entries,
+                 [](const auto &Entry) { return Entry.second.expired(); });
+  std::shared_ptr<T> Shared = Create();
+  Current.Entries.emplace_back(Key, Shared);
+  return Shared;
+}
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNFINDERSHARED_H_
@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNHeaderCache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+#include <dlfcn.h>
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+constexpr llvm::StringLiteral kEntryHeader = "ttnn-header-cache 1";
+
+std::string getEntryPath(llvm::StringRef Directory, llvm::StringRef Key) {
+  llvm::SmallString<256> Path(Directory);
+  llvm::sys::path::append(Path,
+                          llvm::utohexstr(llvm::xxHash64(Key)) + ".ttnnhdr");
+  return std::string(Path);
+}
+
+// Entries are a sequence of header lines, some of them followed by a payload
+// of the byte length given as their last field.
+class EntryReader {
+public:
+  explicit EntryReader(llvm::StringRef Buffer) : Rest(Buffer) {}
+
+  bool atEnd() const { return Rest.empty(); }
+
+  bool readLine(llvm::StringRef &Line) {
+    size_t End = Rest.find('\n');
+    if (End == llvm::StringRef::npos) {
+      return false;
+    }
+    Line = Rest.take_front(End);
+    Rest = Rest.drop_front(End + 1);
+    return true;
+  }
+
+  bool readFields(llvm::SmallVectorImpl<llvm::StringRef> &Fields) {
+    llvm::StringRef Line;
+    if (!readLine(Line)) {
+      return false;
+    }
+    Fields.clear();
+    Line.split(Fields, ' ');
+    return true;
+  }
+
+  bool readPayload(llvm::StringRef LengthField, std::string &Out) {
+    unsigned Length;
+    if (LengthField.getAsInteger(10, Length) || Rest.size() < Length + 1 ||
+        Rest[Length] != '\n') {
+      return false;
+    }
+    Out = Rest.take_front(Length).str();
+    Rest = Rest.drop_front(Length + 1);
+    return true;
+  }
+
+private:
+  llvm::StringRef Rest;
+};
+
+} // namespace
+
+llvm::StringRef getPluginBuildID() {
+  // The plugin binary itself is hashed, so any rebuild invalidates the cache
+  static const std::string BuildID = [] {
+    Dl_info Info;
+    if (!dladdr(reinterpret_cast<void *>(&getPluginBuildID), &Info) ||
+        !Info.dli_fname) {
+      return std::string();
+    }
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Binary =
+        llvm::MemoryBuffer::getFile(Info.dli_fname);
+    if (!Binary) {
+      return std::string();
+    }
+    return llvm::utohexstr(llvm::xxHash64((*Binary)->getBuffer()));
+  }();
+  return BuildID;
+}
+
+std::string getHeaderCacheKey(llvm::StringRef CheckName,
+                              llvm::StringRef HeaderPath,
+                              llvm::StringRef Content,
+                              llvm::StringRef Options) {
+  std::string Key;
+  llvm::raw_string_ostream OS(Key);
+  OS << "check=" << CheckName << ";plugin=" << getPluginBuildID()
+     << ";options=" << llvm::utohexstr(llvm::xxHash64(Options))
+     << ";content=" << llvm::utohexstr(llvm::xxHash64(Content))
+     << ";header=" << HeaderPath;
+  return Key;
+}
+
+std::optional<std::vector<CachedDiagnostic>>
+lookupHeaderDiagnostics(llvm::StringRef Directory, llvm::StringRef Key) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+      llvm::MemoryBuffer::getFile(getEntryPath(Directory, Key),
+                                  /*IsText=*/false,
+                                  /*RequiresNullTerminator=*/false);
+  if (!Buffer) {
+    return std::nullopt;
+  }
+
+  // Anything unexpected, including a hash collision, is treated as a miss
+  EntryReader Reader((*Buffer)->getBuffer());
+  llvm::StringRef Header;
+  llvm::SmallVector<llvm::StringRef, 4> Fields;
+  std::string StoredKey;
+  if (!Reader.readLine(Header) || Header != kEntryHeader) {
+    return std::nullopt;
+  }
+  if (!Reader.readFields(Fields) || Fields.size() != 2 || Fields[0] != "K" ||
+      !Reader.readPayload(Fields[1], StoredKey) || StoredKey != Key) {
+    return std::nullopt;
+  }
+
+  std::vector<CachedDiagnostic> Diagnostics;
+  while (!Reader.atEnd()) {
+    if (!Reader.readFields(Fields)) {
+      return std::nullopt;
+    }
+    if (Fields.size() == 3 && Fields[0] == "D") {
+      CachedDiagnostic Diag;
+      if (Fields[1].getAsInteger(10, Diag.Offset) ||
+          !Reader.readPayload(Fields[2], Diag.Message)) {
+        return std::nullopt;
+      }
+      Diagnostics.push_back(std::move(Diag));
+    } else if (Fields.size() == 4 && Fields[0] == "F" &&
+               !Diagnostics.empty()) {
+      CachedFixIt FixIt;
+      if (Fields[1].getAsInteger(10, FixIt.Offset) ||
+          Fields[2].getAsInteger(10, FixIt.Length) ||
+          !Reader.readPayload(Fields[3], FixIt.Text)) {
+        return std::nullopt;
+      }
+      Diagnostics.back().FixIts.push_back(std::move(FixIt));
+    } else {
+      return std::nullopt;
+    }
+  }
+  return Diagnostics;
+}
+
+llvm::Error storeHeaderDiagnostics(llvm::StringRef Directory,
+                                   llvm::StringRef Key,
+                                   llvm::ArrayRef<CachedDiagnostic> Diagnostics) {
+  if (std::error_code EC = llvm::sys::fs::create_directories(Directory)) {
+    return llvm::createFileError(Directory, EC);
+  }
+
+  std::string EntryPath = getEntryPath(Directory, Key);
+  llvm::SmallString<256> TempPath;
+  int FD;
+  if (std::error_code EC = llvm::sys::fs::createUniqueFile(
+          EntryPath + "-%%%%%%%%.tmp", FD, TempPath)) {
+    return llvm::createFileError(EntryPath, EC);
+  }
+
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << kEntryHeader << '\n';
+    OS << "K " << Key.size() << '\n' << Key << '\n';
+    for (const CachedDiagnostic &Diag : Diagnostics) {
+      OS << "D " << Diag.Offset << ' ' << Diag.Message.size() << '\n'
+         << Diag.Message << '\n';
+      for (const CachedFixIt &FixIt : Diag.FixIts) {
+        OS << "F " << FixIt.Offset << ' ' << FixIt.Length << ' '
+           << FixIt.Text.size() << '\n'
+           << FixIt.Text << '\n';
+      }
+    }
+    OS.close();
+    if (OS.has_error()) {
+      std::error_code EC = OS.error();
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return llvm::createFileError(TempPath, EC);
+    }
+  }
+
+  // Concurrent writers store identical entries; whichever rename lands last
+  // wins, and readers never see a partial file.
+  if (std::error_code EC = llvm::sys::fs::rename(TempPath, EntryPath)) {
+    llvm::sys::fs::remove(TempPath);
+    return llvm::createFileError(EntryPath, EC);
+  }
+  return llvm::Error::success();
+}
+
+} // namespace clang::tidy::ttnn
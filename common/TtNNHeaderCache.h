@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNHEADERCACHE_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNHEADERCACHE_H_
+
+// On-disk cache of the diagnostics a check reports in one header, so a header
+// included by many translation units is analyzed once. Only depends on LLVM
+// Support.
+//
+// Each entry is one file, `<hash>.ttnnhdr`, holding the full key followed by
+// the diagnostics. Entries are written to a temporary file and renamed into
+// place, so any number of clang-tidy processes may share a directory; readers
+// see either no entry or a complete one.
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+/// A fix-it as a replacement of a byte range of the header.
+struct CachedFixIt {
+  unsigned Offset;
+  unsigned Length;
+  std::string Text;
+};
+
+/// A diagnostic with its message already formatted.
+struct CachedDiagnostic {
+  unsigned Offset;
+  std::string Message;
+  std::vector<CachedFixIt> FixIts;
+};
+
+/// Identifies the loaded plugin binary. Empty if it cannot be determined, in
+/// which case nothing should be cached.
+llvm::StringRef getPluginBuildID();
+
+/// Returns the cache key for \p CheckName's diagnostics in the header at
+/// \p HeaderPath with contents \p Content, under options \p Options (any
+/// stable serialization of the check's options).
+std::string getHeaderCacheKey(llvm::StringRef CheckName,
+                              llvm::StringRef HeaderPath,
+                              llvm::StringRef Content,
+                              llvm::StringRef Options);
+
+/// Returns the diagnostics stored under \p Key, or std::nullopt if there is
+/// no usable entry.
+std::optional<std::vector<CachedDiagnostic>>
+lookupHeaderDiagnostics(llvm::StringRef Directory, llvm::StringRef Key);
+
+/// Stores \p Diagnostics under \p Key, replacing any existing entry.
+llvm::Error storeHeaderDiagnostics(llvm::StringRef Directory,
+                                   llvm::StringRef Key,
+                                   llvm::ArrayRef<CachedDiagnostic> Diagnostics);
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNHEADERCACHE_H_
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNHeaderDiagnostics.h"
+#include "TtNNCheck.h"
+#include "clang/Lex/Lexer.h"
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+// Substitutes Args for %0, %1, ... the way the diagnostic engine does for
+// plain string arguments.
+std::string formatMessage(StringRef Message, ArrayRef<StringRef> Args) {
+  std::string Formatted;
+  for (size_t I = 0, E = Message.size(); I != E; ++I) {
+    if (Message[I] == '%' && I + 1 != E) {
+      char Next = Message[I + 1];
+      if (Next == '%') {
+        Formatted += '%';
+        ++I;
+        continue;
+      }
+      if (Next >= '0' && Next <= '9' &&
+          static_cast<size_t>(Next - '0') < Args.size()) {
+        Formatted += Args[Next - '0'];
+        ++I;
+        continue;
+      }
+    }
+    Formatted += Message[I];
+  }
+  return Formatted;
+}
+
+} // namespace
+
+const std::vector<CachedDiagnostic> *
+TtNNHeaderDiagnostics::prepare(FileID FID, const SourceManager &SM,
+                               StringRef Options) {
+  if (!isEnabled() || FID == SM.getMainFileID() || Headers.count(FID)) {
+    return nullptr;
+  }
+  bool Invalid = false;
+  llvm::StringRef Content = SM.getBufferData(FID, &Invalid);
+  std::string Path = getRealPath(FID, SM);
+  if (Invalid || Path.empty()) {
+    return nullptr;
+  }
+
+  Header &Entry = Headers[FID];
+  Entry.Key = getHeaderCacheKey(CheckName, Path, Content, Options);
+  std::optional<std::vector<CachedDiagnostic>> Cached =
+      lookupHeaderDiagnostics(Directory, Entry.Key);
+  if (!Cached) {
+    return nullptr;
+  }
+  Entry.Replayed = true;
+  Entry.Diagnostics = std::move(*Cached);
+  return &Entry.Diagnostics;
+}
+
+bool TtNNHeaderDiagnostics::isReplayed(SourceLocation Loc,
+                                       const SourceManager &SM) const {
+  if (Headers.empty()) {
+    return false;
+  }
+  auto It = Headers.find(SM.getFileID(SM.getExpansionLoc(Loc)));
+  return It != Headers.end() && It->second.Replayed;
+}
+
+bool TtNNHeaderDiagnostics::record(SourceLocation Loc, StringRef Message,
+                                   ArrayRef<StringRef> Args,
+                                   ArrayRef<FixItHint> FixIts,
+                                   const SourceManager &SM,
+                                   const LangOptions &LangOpts) {
+  if (Headers.empty()) {
+    return true;
+  }
+  FileID FID = SM.getFileID(SM.getExpansionLoc(Loc));
+  auto It = Headers.find(FID);
+  if (It == Headers.end()) {
+    return true;
+  }
+
+  Header &Entry = It->second;
+  if (Entry.Replayed) {
+    return false;
+  }
+  if (!Entry.Cacheable) {
+    return true;
+  }
+
+  CachedDiagnostic Diagnostic{SM.getFileOffset(SM.getExpansionLoc(Loc)),
+                              formatMessage(Message, Args),
+                              {}};
+  for (const FixItHint &Hint : FixIts) {
+    CharSourceRange Range =
+        Lexer::makeFileCharRange(Hint.RemoveRange, SM, LangOpts);
+    // Only edits confined to the header itself can be replayed
+    if (Range.isInvalid() || Hint.InsertFromRange.isValid() ||
+        SM.getFileID(Range.getBegin()) != FID ||
+        SM.getFileID(Range.getEnd()) != FID) {
+      Entry.Cacheable = false;
+      Entry.Diagnostics.clear();
+      return true;
+    }
+    unsigned Begin = SM.getFileOffset(Range.getBegin());
+    Diagnostic.FixIts.push_back(
+        {Begin, SM.getFileOffset(Range.getEnd()) - Begin, Hint.CodeToInsert});
+  }
+  Entry.Diagnostics.push_back(std::move(Diagnostic));
+  return true;
+}
+
+llvm::Error TtNNHeaderDiagnostics::flush() {
+  llvm::Error Errors = llvm::Error::success();
+  for (const auto &[FID, Entry] : Headers) {
+    if (Entry.Replayed || !Entry.Cacheable) {
+      continue;
+    }
+    Errors = llvm::joinErrors(
+        std::move(Errors),
+        storeHeaderDiagnostics(Directory, Entry.Key, Entry.Diagnostics));
+  }
+  Headers.clear();
+  return Errors;
+}
+
+} // namespace clang::tidy::ttnn
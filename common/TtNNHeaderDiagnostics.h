@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNHEADERDIAGNOSTICS_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNHEADERDIAGNOSTICS_H_
+
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Basic/SourceManager.h"
+#include "common/TtNNHeaderCache.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/Error.h"
+
+#include <string>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+/// The header cache entries of one check over one translation unit: which
+/// headers it analyzes, which of them were replayed, and the diagnostics it
+/// reports in the others, to be stored when the translation unit ends.
+class TtNNHeaderDiagnostics {
+public:
+  /// Caches under \p Directory; does nothing if it is empty.
+  TtNNHeaderDiagnostics(std::string CheckName, std::string Directory)
+      : CheckName(std::move(CheckName)), Directory(std::move(Directory)) {}
+
+  /// Returns true if a directory is set and the plugin build can be
+  /// identified; without a build ID a stale entry could never be told apart.
+  bool isEnabled() const {
+    return !Directory.empty() && !getPluginBuildID().empty();
+  }
+
+  /// Starts caching the header \p FID, keyed by its path and content and by
+  /// \p Options. Returns the diagnostics to replay if an entry was found, and
+  /// null otherwise or if the header was already prepared. The result is only
+  /// valid until the next call.
+  const std::vector<CachedDiagnostic> *
+  prepare(FileID FID, const SourceManager &SM, llvm::StringRef Options);
+
+  /// Returns true if \p Loc is in a header whose diagnostics were replayed.
+  bool isReplayed(SourceLocation Loc, const SourceManager &SM) const;
+
+  /// Records a diagnostic about to be reported at \p Loc, with \p Args
+  /// substituted for `%0`, `%1`, ... in \p Message. A header whose fixes
+  /// reach outside of it is not stored. Returns false if \p Loc is in a
+  /// replayed header, in which case the diagnostic must not be reported.
+  bool record(SourceLocation Loc, llvm::StringRef Message,
+              llvm::ArrayRef<llvm::StringRef> Args,
+              llvm::ArrayRef<FixItHint> FixIts, const SourceManager &SM,
+              const LangOptions &LangOpts);
+
+  /// Stores the diagnostics of the headers analyzed, rather than replayed,
+  /// in this translation unit and forgets all headers.
+  llvm::Error flush();
+
+private:
+  struct Header {
+    std::string Key;
+    bool Replayed = false;
+    bool Cacheable = true;
+    std::vector<CachedDiagnostic> Diagnostics;
+  };
+
+  const std::string CheckName;
+  const std::string Directory;
+  llvm::DenseMap<FileID, Header> Headers;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNHEADERDIAGNOSTICS_H_
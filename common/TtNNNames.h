@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNNAMES_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNNAMES_H_
+
+// Names and naming rules shared by the checks and the standalone tools. This
+// header only depends on LLVM Support.
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <cctype>
+#include <string>
+
+namespace clang::tidy::ttnn {
+
+// Namespace-level TTNN type names rewritten by the checks
+constexpr const char *kSpecReturnValueT = "spec_return_value_t";
+constexpr const char *kTensorReturnValueT = "tensor_return_value_t";
+constexpr const char *kOperationAttributesT = "operation_attributes_t";
+constexpr const char *kTensorArgsT = "tensor_args_t";
+
+// Program factory members, and the alias of the kernel handles they keep
+constexpr const char *kSharedVariablesT = "shared_variables_t";
+constexpr const char *kCachedProgramT = "cached_program_t";
+constexpr const char *kKernelHandle = "KernelHandle";
+
+// Types whose copies the performance checks look for
+constexpr const char *kTensor = "Tensor";
+constexpr const char *kMemoryConfig = "MemoryConfig";
+
+// Nanobind binding helpers matched by ttnn-nanobind-unnecessary-overload
+constexpr const char *kBindRegisteredOperation = "bind_registered_operation";
+constexpr const char *kNanobindOverloadT = "nanobind_overload_t";
+constexpr const char *kNanobindArgumentsT = "nanobind_arguments_t";
+
+// Namespaces that group operations rather than name one, e.g. the
+// `data_movement` in ttnn::operations::data_movement::slice. Default of the
+// naming check's CategoryNamespaces option.
+constexpr const char *kDefaultCategoryNamespaces =
+    "ttnn;operations;data_movement;eltwise;binary;unary;reduction;matmul;"
+    "conv;pool;normalization;transformer;embedding;loss;kv_cache;ccl;moreh;"
+    "experimental;creation;copy;reshape_common;reshape_on_device;program";
+
+// Names the checks are registered under
+constexpr const char *kNanobindOverloadCheckName =
+    "ttnn-nanobind-unnecessary-overload";
+constexpr const char *kReturnValueTypeAliasCheckName =
+    "ttnn-return-value-type-alias";
+constexpr const char *kOperationTypeNamingCheckName =
+    "ttnn-operation-type-naming";
+constexpr const char *kTensorPassByValueCheckName = "ttnn-tensor-pass-by-value";
+constexpr const char *kReflectionProgramHashCheckName =
+    "ttnn-reflection-program-hash";
+constexpr const char *kNanobindLambdaByValueCheckName =
+    "ttnn-nanobind-lambda-by-value";
+constexpr const char *kProgramFactoryRuntimeArgsCheckName =
+    "ttnn-program-factory-runtime-args";
+
+// A check and the identifiers its matchers are built from. A translation unit
+// that spells none of them, directly or through a macro, cannot produce a
+// diagnostic from the check. A check that starts matching another name must
+// add it here, or ttnn-tidy's pre-filter would skip translation units it
+// reports on.
+struct TtNNCheckTriggers {
+  llvm::StringRef Check;
+  llvm::ArrayRef<llvm::StringRef> Identifiers;
+};
+
+inline constexpr llvm::StringRef kNanobindOverloadTriggers[] = {
+    kBindRegisteredOperation, kNanobindOverloadT};
+inline constexpr llvm::StringRef kReturnValueTypeAliasTriggers[] = {
+    kSpecReturnValueT, kTensorReturnValueT};
+inline constexpr llvm::StringRef kOperationTypeNamingTriggers[] = {
+    kOperationAttributesT, kTensorArgsT};
+inline constexpr llvm::StringRef kTensorPassByValueTriggers[] = {kTensor};
+// Every device operation declares its operation_attributes_t member
+inline constexpr llvm::StringRef kReflectionProgramHashTriggers[] = {
+    kOperationAttributesT};
+inline constexpr llvm::StringRef kNanobindLambdaByValueTriggers[] = {
+    kNanobindOverloadT};
+// The semantic model only takes a struct for a program factory when it
+// declares one of these members
+inline constexpr llvm::StringRef kProgramFactoryRuntimeArgsTriggers[] = {
+    kSharedVariablesT, kCachedProgramT};
+
+// Every check in the plugin, as registered by the module
+inline llvm::ArrayRef<TtNNCheckTriggers> getTtNNCheckTriggers() {
+  static constexpr TtNNCheckTriggers Checks[] = {
+      {kNanobindOverloadCheckName, kNanobindOverloadTriggers},
+      {kReturnValueTypeAliasCheckName, kReturnValueTypeAliasTriggers},
+      {kOperationTypeNamingCheckName, kOperationTypeNamingTriggers},
+      {kTensorPassByValueCheckName, kTensorPassByValueTriggers},
+      {kReflectionProgramHashCheckName, kReflectionProgramHashTriggers},
+      {kNanobindLambdaByValueCheckName, kNanobindLambdaByValueTriggers},
+      {kProgramFactoryRuntimeArgsCheckName,
+       kProgramFactoryRuntimeArgsTriggers},
+  };
+  return Checks;
+}
+
+// Check if the file is a types file (*_device_operation_types.hpp)
+inline bool isTypesFile(llvm::StringRef Filename) {
+  return Filename.ends_with("_device_operation_types.hpp");
+}
+
+// Convert snake_case or lowercase to PascalCase
+// e.g., "slice" -> "Slice", "conv2d" -> "Conv2d", "batch_norm" -> "BatchNorm"
+inline std::string toPascalCase(llvm::StringRef Name) {
+  std::string Result;
+  bool CapitalizeNext = true;
+
+  for (char C : Name) {
+    if (C == '_') {
+      CapitalizeNext = true;
+    } else {
+      if (CapitalizeNext) {
+        Result += std::toupper(static_cast<unsigned char>(C));
+        CapitalizeNext = false;
+      } else {
+        Result += C;
+      }
+    }
+  }
+
+  return Result;
+}
+
+// Get the suggested replacement name for the struct
+// operation_attributes_t -> {Operation}Params
+// tensor_args_t -> {Operation}Inputs
+inline std::string getSuggestedName(llvm::StringRef CurrentName,
+                                    llvm::StringRef OperationName) {
+  std::string PascalOp = toPascalCase(OperationName);
+
+  if (CurrentName == kOperationAttributesT) {
+    return PascalOp + "Params";
+  } else if (CurrentName == kTensorArgsT) {
+    return PascalOp + "Inputs";
+  }
+
+  return "";
+}
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNNAMES_H_
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNRenameIndex.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+constexpr llvm::StringLiteral kShardHeader = "ttnn-rename-index 1";
+
+llvm::Error makeParseError(llvm::StringRef Path, unsigned Line,
+                           const llvm::Twine &Message) {
+  return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                 Path + ":" + llvm::Twine(Line) + ": " +
+                                     Message);
+}
+
+} // namespace
+
+unsigned RenameIndex::intern(llvm::StringRef Text) {
+  auto [It, Inserted] = Ids.try_emplace(Text, Strings.size());
+  if (Inserted) {
+    Strings.push_back(It->getKey());
+  }
+  return It->second;
+}
+
+llvm::Error RenameIndex::writeShard(llvm::StringRef Directory,
+                                    llvm::StringRef MainFile) const {
+  if (std::error_code EC = llvm::sys::fs::create_directories(Directory)) {
+    return llvm::createFileError(Directory, EC);
+  }
+
+  // One shard per main file; the hash keeps same-named files apart
+  llvm::SmallString<256> ShardPath(Directory);
+  llvm::sys::path::append(
+      ShardPath, llvm::sys::path::filename(MainFile) + "-" +
+                     llvm::utohexstr(llvm::xxHash64(MainFile)) + ".ttnnidx");
+
+  llvm::SmallString<256> TempPath;
+  int FD;
+  if (std::error_code EC = llvm::sys::fs::createUniqueFile(
+          ShardPath + "-%%%%%%%%.tmp", FD, TempPath)) {
+    return llvm::createFileError(ShardPath, EC);
+  }
+
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << kShardHeader << '\n';
+    for (llvm::StringRef S : Strings) {
+      OS << "S " << S << '\n';
+    }
+    for (const RenameIndexRecord &R : Records) {
+      OS << (R.Kind == RenameIndexRecord::Definition ? 'D' : 'U') << ' '
+         << R.Key << ' ' << R.Operation << ' ' << R.File << ' ' << R.Offset
+         << ' ' << R.Length << '\n';
+    }
+    OS.close();
+    if (OS.has_error()) {
+      std::error_code EC = OS.error();
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return llvm::createFileError(TempPath, EC);
+    }
+  }
+
+  if (std::error_code EC = llvm::sys::fs::rename(TempPath, ShardPath)) {
+    llvm::sys::fs::remove(TempPath);
+    return llvm::createFileError(ShardPath, EC);
+  }
+  return llvm::Error::success();
+}
+
+llvm::Error RenameIndex::readShard(llvm::StringRef Path) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+      llvm::MemoryBuffer::getFile(Path);
+  if (!Buffer) {
+    return llvm::createFileError(Path, Buffer.getError());
+  }
+
+  llvm::SmallVector<llvm::StringRef, 0> Lines;
+  (*Buffer)->getBuffer().split(Lines, '\n', /*MaxSplit=*/-1,
+                               /*KeepEmpty=*/false);
+  if (Lines.empty() || Lines.front() != kShardHeader) {
+    return makeParseError(Path, 1, "not a ttnn rename index shard");
+  }
+
+  // Shard-local string ids are remapped onto this index's table
+  std::vector<unsigned> LocalIds;
+  for (unsigned I = 1, E = Lines.size(); I != E; ++I) {
+    llvm::StringRef Line = Lines[I];
+    if (Line.consume_front("S ")) {
+      LocalIds.push_back(intern(Line));
+      continue;
+    }
+
+    RenameIndexRecord Record;
+    if (Line.consume_front("D ")) {
+      Record.Kind = RenameIndexRecord::Definition;
+    } else if (Line.consume_front("U ")) {
+      Record.Kind = RenameIndexRecord::Usage;
+    } else {
+      return makeParseError(Path, I + 1, "unknown record");
+    }
+
+    llvm::SmallVector<llvm::StringRef, 5> Fields;
+    Line.split(Fields, ' ');
+    unsigned Values[5];
+    if (Fields.size() != 5) {
+      return makeParseError(Path, I + 1, "malformed record");
+    }
+    for (unsigned F = 0; F != 5; ++F) {
+      if (Fields[F].getAsInteger(10, Values[F])) {
+        return makeParseError(Path, I + 1, "malformed record");
+      }
+    }
+    for (unsigned F = 0; F != 3; ++F) {
+      if (Values[F] >= LocalIds.size()) {
+        return makeParseError(Path, I + 1, "unknown string id");
+      }
+      Values[F] = LocalIds[Values[F]];
+    }
+
+    Record.Key = Values[0];
+    Record.Operation = Values[1];
+    Record.File = Values[2];
+    Record.Offset = Values[3];
+    Record.Length = Values[4];
+    Records.push_back(Record);
+  }
+  return llvm::Error::success();
+}
+
+} // namespace clang::tidy::ttnn
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNRENAMEINDEX_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNRENAMEINDEX_H_
+
+// On-disk index of operation_attributes_t/tensor_args_t definitions and
+// usages, written per TU by `ttnn-operation-type-naming` in index mode and
+// merged by `ttnn-rename-apply`. Only depends on LLVM Support.
+//
+// A shard is a text file:
+//
+//   ttnn-rename-index 1
+//   S <text>                                 string table entry (ids from 0)
+//   D <key> <operation> <file> <offset> <length>
+//   U <key> <operation> <file> <offset> <length>
+//
+// where <key> (qualified struct name), <operation> and <file> (real path) are
+// string table ids. D records cover the struct name token of a definition, U
+// records the whole written type of a usage.
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+
+#include <string>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+struct RenameIndexRecord {
+  enum RecordKind { Definition, Usage };
+
+  RecordKind Kind;
+  unsigned Key;
+  unsigned Operation;
+  unsigned File;
+  unsigned Offset;
+  unsigned Length;
+};
+
+class RenameIndex {
+public:
+  /// Returns the string table id of \p Text, adding it if needed.
+  unsigned intern(llvm::StringRef Text);
+  llvm::StringRef getString(unsigned Id) const { return Strings[Id]; }
+
+  void add(const RenameIndexRecord &Record) { Records.push_back(Record); }
+  const std::vector<RenameIndexRecord> &records() const { return Records; }
+  bool empty() const { return Records.empty(); }
+
+  /// Writes this index as a shard for \p MainFile into \p Directory. The
+  /// shard is written to a temporary file and renamed into place, so
+  /// concurrent writers never leave a partial shard behind.
+  llvm::Error writeShard(llvm::StringRef Directory,
+                         llvm::StringRef MainFile) const;
+
+  /// Parses the shard at \p Path and merges its records into this index.
+  llvm::Error readShard(llvm::StringRef Path);
+
+private:
+  llvm::StringMap<unsigned> Ids;
+  std::vector<llvm::StringRef> Strings; // points into Ids' keys
+  std::vector<RenameIndexRecord> Records;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNRENAMEINDEX_H_
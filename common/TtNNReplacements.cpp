@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNReplacements.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+constexpr llvm::StringLiteral kMagic = "TTNNFIX1";
+
+/// Reads little-endian integers and string table entries from a buffer,
+/// failing on the first read past its end.
+class Reader {
+public:
+  explicit Reader(llvm::StringRef Buffer) : Buffer(Buffer) {}
+
+  bool read(uint32_t &Value) { return readInteger(Value); }
+  bool read(uint64_t &Value) { return readInteger(Value); }
+
+  bool read(llvm::StringRef &Value) {
+    uint32_t Length;
+    if (!read(Length) || Buffer.size() - Pos < Length) {
+      return false;
+    }
+    Value = Buffer.substr(Pos, Length);
+    Pos += Length;
+    return true;
+  }
+
+  /// Returns true if at least \p Count records of \p Size bytes remain, so
+  /// a corrupt count cannot make the caller reserve unbounded memory.
+  bool hasRecords(uint32_t Count, size_t Size) const {
+    return (Buffer.size() - Pos) / Size >= Count;
+  }
+
+  bool atEnd() const { return Pos == Buffer.size(); }
+
+private:
+  template <typename T> bool readInteger(T &Value) {
+    if (Buffer.size() - Pos < sizeof(T)) {
+      return false;
+    }
+    Value = llvm::support::endian::read<T, llvm::support::little,
+                                        llvm::support::unaligned>(
+        Buffer.data() + Pos);
+    Pos += sizeof(T);
+    return true;
+  }
+
+  llvm::StringRef Buffer;
+  size_t Pos = 0;
+};
+
+llvm::Error makeParseError(llvm::StringRef Name, const llvm::Twine &Message) {
+  return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                 Name + ": " + Message);
+}
+
+} // namespace
+
+uint64_t getReplacementsContentHash(llvm::StringRef Content) {
+  return llvm::xxHash64(Content);
+}
+
+unsigned CompactReplacementsWriter::intern(llvm::StringRef Text) {
+  auto [It, Inserted] = Ids.try_emplace(Text, Strings.size());
+  if (Inserted) {
+    Strings.push_back(It->getKey());
+  }
+  return It->second;
+}
+
+void CompactReplacementsWriter::add(llvm::StringRef File, unsigned Offset,
+                                    unsigned Length, llvm::StringRef Text) {
+  auto [It, Inserted] = FileIndices.try_emplace(File, Files.size());
+  if (Inserted) {
+    Files.push_back(intern(File));
+  }
+  Replacements.emplace(It->second, Offset, Length, intern(Text));
+}
+
+llvm::Error CompactReplacementsWriter::write(llvm::StringRef Path) const {
+  llvm::SmallString<256> TempPath;
+  int FD;
+  if (std::error_code EC = llvm::sys::fs::createUniqueFile(
+          Path + "-%%%%%%%%.tmp", FD, TempPath)) {
+    return llvm::createFileError(Path, EC);
+  }
+
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    llvm::support::endian::Writer W(OS, llvm::support::little);
+    OS << kMagic;
+
+    W.write<uint32_t>(Strings.size());
+    for (llvm::StringRef S : Strings) {
+      W.write<uint32_t>(S.size());
+      OS << S;
+    }
+
+    // The hash lets the apply tool refuse files edited since the analysis
+    W.write<uint32_t>(Files.size());
+    for (unsigned File : Files) {
+      uint64_t Hash = 0;
+      if (llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Content =
+              llvm::MemoryBuffer::getFile(Strings[File], /*IsText=*/false,
+                                          /*RequiresNullTerminator=*/false)) {
+        Hash = getReplacementsContentHash((*Content)->getBuffer());
+      }
+      W.write<uint32_t>(File);
+      W.write<uint64_t>(Hash);
+    }
+
+    W.write<uint32_t>(Replacements.size());
+    for (const auto &[File, Offset, Length, Text] : Replacements) {
+      W.write<uint32_t>(File);
+      W.write<uint32_t>(Offset);
+      W.write<uint32_t>(Length);
+      W.write<uint32_t>(Text);
+    }
+
+    OS.close();
+    if (OS.has_error()) {
+      std::error_code EC = OS.error();
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return llvm::createFileError(TempPath, EC);
+    }
+  }
+
+  if (std::error_code EC = llvm::sys::fs::rename(TempPath, Path)) {
+    llvm::sys::fs::remove(TempPath);
+    return llvm::createFileError(Path, EC);
+  }
+  return llvm::Error::success();
+}
+
+llvm::Expected<CompactReplacements>
+readCompactReplacements(llvm::StringRef Buffer, llvm::StringRef Name) {
+  if (!Buffer.consume_front(kMagic)) {
+    return makeParseError(Name, "not a ttnn replacements file");
+  }
+
+  Reader R(Buffer);
+  uint32_t Count;
+  if (!R.read(Count) || !R.hasRecords(Count, sizeof(uint32_t))) {
+    return makeParseError(Name, "truncated string table");
+  }
+  std::vector<llvm::StringRef> Strings(Count);
+  for (llvm::StringRef &S : Strings) {
+    if (!R.read(S)) {
+      return makeParseError(Name, "truncated string table");
+    }
+  }
+
+  CompactReplacements Result;
+  if (!R.read(Count) || !R.hasRecords(Count, 12)) {
+    return makeParseError(Name, "truncated file table");
+  }
+  Result.Files.reserve(Count);
+  for (uint32_t I = 0; I != Count; ++I) {
+    uint32_t PathId;
+    uint64_t Hash;
+    R.read(PathId);
+    R.read(Hash);
+    if (PathId >= Strings.size()) {
+      return makeParseError(Name, "unknown string id");
+    }
+    Result.Files.push_back({Strings[PathId], Hash});
+  }
+
+  if (!R.read(Count) || !R.hasRecords(Count, 16)) {
+    return makeParseError(Name, "truncated replacements");
+  }
+  Result.Replacements.reserve(Count);
+  for (uint32_t I = 0; I != Count; ++I) {
+    uint32_t File, Offset, Length, Text;
+    R.read(File);
+    R.read(Offset);
+    R.read(Length);
+    R.read(Text);
+    if (File >= Result.Files.size() || Text >= Strings.size()) {
+      return makeParseError(Name, "unknown file or string id");
+    }
+    Result.Replacements.push_back({File, Offset, Length, Strings[Text]});
+  }
+
+  if (!R.atEnd()) {
+    return makeParseError(Name, "trailing data");
+  }
+  return Result;
+}
+
+} // namespace clang::tidy::ttnn
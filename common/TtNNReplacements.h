@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNREPLACEMENTS_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNREPLACEMENTS_H_
+
+// Compact binary replacements file, written by `ttnn-tidy -export-
+// replacements` and applied by `ttnn-apply-fixes`. Only depends on LLVM
+// Support.
+//
+// All integers are little-endian. A file is:
+//
+//   "TTNNFIX1"                                        magic
+//   u32 count, { u32 length, bytes }...               string table
+//   u32 count, { u32 path, u64 content hash }...      files
+//   u32 count, { u32 file, u32 offset, u32 length,
+//                u32 text }...                        replacements
+//
+// where path and text are string table ids and file is an index into the
+// file table. A file's content hash is the xxHash64 of the file as it was
+// analyzed, or 0 if it was not known. Every path and replacement text is
+// stored once, and identical replacements once, however many translation
+// units reported them.
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+
+#include <cstdint>
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+/// Collects replacements and writes them as a compact replacements file.
+class CompactReplacementsWriter {
+public:
+  /// Adds a replacement of \p Length bytes at \p Offset in \p File by
+  /// \p Text. Duplicates are dropped.
+  void add(llvm::StringRef File, unsigned Offset, unsigned Length,
+           llvm::StringRef Text);
+
+  size_t size() const { return Replacements.size(); }
+
+  /// Writes the replacements to \p Path, hashing every file they touch. The
+  /// file is written to a temporary file and renamed into place.
+  llvm::Error write(llvm::StringRef Path) const;
+
+private:
+  unsigned intern(llvm::StringRef Text);
+
+  llvm::StringMap<unsigned> Ids;
+  std::vector<llvm::StringRef> Strings; // points into Ids' keys
+  llvm::StringMap<unsigned> FileIndices;
+  std::vector<unsigned> Files; // path string ids
+  // (file, offset, length, text)
+  std::set<std::tuple<unsigned, unsigned, unsigned, unsigned>> Replacements;
+};
+
+/// A compact replacements file parsed in place. Every StringRef points into
+/// the buffer it was read from.
+struct CompactReplacements {
+  struct File {
+    llvm::StringRef Path;
+    uint64_t Hash;
+  };
+
+  struct Replacement {
+    uint32_t File;
+    uint32_t Offset;
+    uint32_t Length;
+    llvm::StringRef Text;
+  };
+
+  std::vector<File> Files;
+  std::vector<Replacement> Replacements;
+};
+
+/// Returns the hash stored for a file's content.
+uint64_t getReplacementsContentHash(llvm::StringRef Content);
+
+/// Parses the compact replacements file in \p Buffer, named \p Name in
+/// errors, without copying any strings.
+llvm::Expected<CompactReplacements>
+readCompactReplacements(llvm::StringRef Buffer, llvm::StringRef Name);
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNREPLACEMENTS_H_
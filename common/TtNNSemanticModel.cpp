@@ -0,0 +1,506 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNSemanticModel.h"
+#include "TtNNFinderShared.h"
+#include "TtNNNames.h"
+#include "TtNNTypeDispatcher.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/AST/RecursiveASTVisitor.h"
+#include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <utility>
+
+using namespace clang::ast_matchers;
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+bool isNamed(const NamedDecl &D, StringRef Name) {
+  return D.getIdentifier() && D.getName() == Name;
+}
+
+/// The lambda a `nanobind_overload_t` temporary is constructed from.
+const LambdaExpr *getOverloadLambda(const Expr &Overload) {
+  const auto *Temporary = dyn_cast<CXXTemporaryObjectExpr>(&Overload);
+  if (!Temporary || Temporary->getNumArgs() < 1) {
+    return nullptr;
+  }
+  return dyn_cast<LambdaExpr>(Temporary->getArg(0)->IgnoreImplicit());
+}
+
+/// Collects the `bind_registered_operation` calls under the declarations it
+/// traverses.
+class BindingCallFinder : public RecursiveASTVisitor<BindingCallFinder> {
+public:
+  explicit BindingCallFinder(std::vector<const CallExpr *> &Calls)
+      : Calls(Calls) {}
+
+  bool VisitCallExpr(CallExpr *Call) {
+    const FunctionDecl *Callee = Call->getDirectCallee();
+    if (Callee && isNamed(*Callee, kBindRegisteredOperation)) {
+      Calls.push_back(Call);
+    }
+    return true;
+  }
+
+private:
+  std::vector<const CallExpr *> &Calls;
+};
+
+/// Collects the functions named other than as the callee of a call.
+class FunctionReferenceFinder
+    : public RecursiveASTVisitor<FunctionReferenceFinder> {
+public:
+  explicit FunctionReferenceFinder(
+      llvm::DenseSet<const FunctionDecl *> &Referenced)
+      : Referenced(Referenced) {}
+
+  // As for the AST matchers, instantiations and implicit code count too
+  bool shouldVisitTemplateInstantiations() const { return true; }
+  bool shouldVisitImplicitCode() const { return true; }
+
+  // A call is visited before its callee
+  bool VisitCallExpr(CallExpr *Call) {
+    if (const auto *Callee =
+            dyn_cast<DeclRefExpr>(Call->getCallee()->IgnoreImplicit())) {
+      Callees.insert(Callee);
+    }
+    return true;
+  }
+
+  bool VisitDeclRefExpr(DeclRefExpr *Reference) {
+    const auto *Function = dyn_cast<FunctionDecl>(Reference->getDecl());
+    if (Function && !Callees.contains(Reference)) {
+      Referenced.insert(Function->getCanonicalDecl());
+    }
+    return true;
+  }
+
+private:
+  llvm::DenseSet<const DeclRefExpr *> Callees;
+  llvm::DenseSet<const FunctionDecl *> &Referenced;
+};
+
+} // namespace
+
+std::shared_ptr<TtNNSemanticModel>
+TtNNSemanticModel::attach(MatchFinder *Finder, StringRef CategoryNamespaces) {
+  auto Create = [&] {
+    auto Model = std::make_shared<TtNNSemanticModel>();
+    llvm::SmallVector<StringRef, 32> Namespaces;
+    CategoryNamespaces.split(Namespaces, ';', /*MaxSplit=*/-1,
+                             /*KeepEmpty=*/false);
+    for (StringRef Namespace : Namespaces) {
+      Model->CategoryNamespaces.insert(Namespace.trim());
+    }
+    Finder->addMatcher(translationUnitDecl().bind("ttnn_model_unit"),
+                       Model.get());
+    return Model;
+  };
+
+  // One model per MatchFinder (i.e. per translation unit) and category list,
+  // as for the type dispatcher
+  return getFinderShared<TtNNSemanticModel>(Finder, CategoryNamespaces.str(),
+                                            Create);
+}
+
+void TtNNSemanticModel::run(const MatchFinder::MatchResult &Result) {
+  if (Result.Nodes.getNodeAs<TranslationUnitDecl>("ttnn_model_unit")) {
+    Context = Result.Context;
+  }
+}
+
+void TtNNSemanticModel::onEndOfTranslationUnit() {
+  // The answers hold pointers into the AST, which is about to go away
+  Context = nullptr;
+  Namespaces.clear();
+  Operations.clear();
+  OperationsNamespaces.clear();
+  TypesFiles.clear();
+  DirectTensorAliases.clear();
+  ProgramFactories.clear();
+  BindingCalls.clear();
+  NanobindOverloadTemplate.reset();
+  OperationIndex.reset();
+  ProgramFactoryIndex.reset();
+  BindingCallIndex.reset();
+  ReferencedFunctions.reset();
+}
+
+StringRef TtNNSemanticModel::getID() const { return "ttnn-semantic-model"; }
+
+TtNNOperation *TtNNSemanticModel::getOperationFor(const NamespaceDecl *NS,
+                                                  bool NamedByCategory) {
+  const NamespaceDecl *Canonical = NS->getCanonicalDecl();
+  std::unique_ptr<TtNNOperation> &Operation = Operations[Canonical];
+  if (!Operation) {
+    Operation = std::make_unique<TtNNOperation>();
+    Operation->Namespace = Canonical;
+    // Names point into the identifier table, which outlives the model's
+    // answers
+    Operation->Name = Canonical->getName();
+    Operation->NamedByCategory = NamedByCategory;
+  }
+  return Operation.get();
+}
+
+TtNNSemanticModel::ResolvedNamespace
+TtNNSemanticModel::resolveNamespace(const NamespaceDecl *NS) {
+  auto It = Namespaces.find(NS);
+  if (It != Namespaces.end()) {
+    return It->second;
+  }
+
+  StringRef Name = NS->getName();
+  ResolvedNamespace Result;
+  if (!Name.empty() && !CategoryNamespaces.contains(Name)) {
+    Result = {getOperationFor(NS, /*NamedByCategory=*/false),
+              /*IsCategory=*/false};
+  } else {
+    const DeclContext *Parent = NS->getParent();
+    while (Parent && !isa<NamespaceDecl>(Parent)) {
+      Parent = Parent->getParent();
+    }
+    if (Parent) {
+      Result = resolveNamespace(cast<NamespaceDecl>(Parent));
+    }
+    if (Result.IsCategory && !Name.empty()) {
+      Result.Operation = getOperationFor(NS, /*NamedByCategory=*/true);
+    }
+  }
+
+  Namespaces[NS] = Result;
+  return Result;
+}
+
+const TtNNOperation *TtNNSemanticModel::getOperation(const DeclContext *DC) {
+  while (DC && !isa<NamespaceDecl>(DC)) {
+    DC = DC->getParent();
+  }
+  if (!DC) {
+    return nullptr;
+  }
+  return resolveNamespace(cast<NamespaceDecl>(DC)).Operation;
+}
+
+bool TtNNSemanticModel::isInOperationsNamespace(const DeclContext *DC) {
+  while (DC && !isa<NamespaceDecl>(DC)) {
+    DC = DC->getParent();
+  }
+  if (!DC) {
+    return false;
+  }
+
+  const auto *NS = cast<NamespaceDecl>(DC);
+  auto It = OperationsNamespaces.find(NS);
+  if (It != OperationsNamespaces.end()) {
+    return It->second;
+  }
+  const auto *Parent = dyn_cast<NamespaceDecl>(NS->getParent());
+  bool Result = (isNamed(*NS, "operations") && Parent &&
+                 isNamed(*Parent, "ttnn") &&
+                 Parent->getParent()->isTranslationUnit()) ||
+                isInOperationsNamespace(NS->getParent());
+  OperationsNamespaces[NS] = Result;
+  return Result;
+}
+
+bool TtNNSemanticModel::isInTypesFile(SourceLocation Loc) {
+  const SourceManager &SM = Context->getSourceManager();
+  Loc = SM.getExpansionLoc(Loc);
+  if (Loc.isInvalid()) {
+    return false;
+  }
+  FileID FID = SM.getFileID(Loc);
+  auto [It, Inserted] = TypesFiles.try_emplace(FID, false);
+  if (Inserted) {
+    It->second = isTypesFile(SM.getFilename(SM.getLocForStartOfFile(FID)));
+  }
+  return It->second;
+}
+
+bool TtNNSemanticModel::isDirectTensorAlias(const TypeAliasDecl &Alias) {
+  auto [It, Inserted] = DirectTensorAliases.try_emplace(&Alias, false);
+  if (!Inserted) {
+    return It->second;
+  }
+
+  // The spellings are `Tensor`, `class Tensor`, `ttnn::Tensor` and
+  // `class ttnn::Tensor`, and the same for TensorSpec. The sugar of the
+  // written type tells them apart without printing it.
+  QualType Type = Alias.getUnderlyingType();
+  if (Type.hasLocalQualifiers()) {
+    return false;
+  }
+  if (const auto *Elaborated = dyn_cast<ElaboratedType>(Type.getTypePtr())) {
+    if (const NestedNameSpecifier *Qualifier = Elaborated->getQualifier()) {
+      const NamespaceDecl *NS = Qualifier->getAsNamespace();
+      if (!NS || Qualifier->getPrefix() || !isNamed(*NS, "ttnn")) {
+        return false;
+      }
+    }
+    Type = Elaborated->getNamedType();
+    if (Type.hasLocalQualifiers()) {
+      return false;
+    }
+  }
+
+  const NamedDecl *Named = nullptr;
+  if (const auto *Using = dyn_cast<UsingType>(Type.getTypePtr())) {
+    Named = Using->getFoundDecl();
+  } else if (const auto *Typedef = dyn_cast<TypedefType>(Type.getTypePtr())) {
+    Named = Typedef->getDecl();
+  } else if (const auto *Record = dyn_cast<RecordType>(Type.getTypePtr())) {
+    Named = Record->getDecl();
+  }
+  It->second = Named && (isNamed(*Named, "Tensor") ||
+                         isNamed(*Named, "TensorSpec"));
+  return It->second;
+}
+
+bool TtNNSemanticModel::isTensorRecord(const CXXRecordDecl &Record) {
+  if (!isNamed(Record, kTensor)) {
+    return false;
+  }
+  // Enclosing namespaces, innermost first, without inline ones
+  llvm::SmallVector<StringRef, 2> Namespaces;
+  for (const DeclContext *DC = Record.getDeclContext();
+       !DC->isTranslationUnit(); DC = DC->getParent()) {
+    const auto *NS = dyn_cast<NamespaceDecl>(DC);
+    if (!NS) {
+      return false;
+    }
+    if (!NS->isInline()) {
+      Namespaces.push_back(NS->getName());
+    }
+  }
+  return (Namespaces.size() == 1 && Namespaces[0] == "ttnn") ||
+         (Namespaces.size() == 2 && Namespaces[0] == "tt_metal" &&
+          Namespaces[1] == "tt");
+}
+
+bool TtNNSemanticModel::isDeviceOperation(const CXXRecordDecl &Record) {
+  return Record.getIdentifier() &&
+         Record.getName().ends_with("DeviceOperation");
+}
+
+const TtNNProgramFactory *
+TtNNSemanticModel::getProgramFactory(const CXXRecordDecl &Record) {
+  const CXXRecordDecl *Definition = Record.getDefinition();
+  if (!Definition) {
+    return nullptr;
+  }
+  auto It = ProgramFactories.find(Definition);
+  if (It != ProgramFactories.end()) {
+    return It->second.get();
+  }
+
+  auto Factory = std::make_unique<TtNNProgramFactory>();
+  Factory->Record = Definition;
+  bool HasProgramMember = false;
+  for (const Decl *D : Definition->decls()) {
+    const auto *Member = dyn_cast<NamedDecl>(D);
+    if (!Member || !Member->getIdentifier() || Member->isImplicit()) {
+      continue;
+    }
+    StringRef Name = Member->getName();
+    if (Name == kSharedVariablesT &&
+        (isa<CXXRecordDecl>(Member) || isa<TypedefNameDecl>(Member))) {
+      Factory->SharedVariables = Member;
+      HasProgramMember = true;
+    } else if (Name == kCachedProgramT) {
+      HasProgramMember = true;
+    } else if (const auto *Method = dyn_cast<CXXMethodDecl>(Member);
+               Method && Method->isStatic()) {
+      if (Name == "create") {
+        Factory->Create = Method;
+      } else if (Name == "override_runtime_arguments") {
+        Factory->OverrideRuntimeArguments = Method;
+      }
+    }
+  }
+
+  // The members, rather than the struct's name, keep the ttnn-tidy
+  // pre-filter's triggers sufficient
+  if (!Factory->Create || !HasProgramMember) {
+    Factory.reset();
+  } else {
+    Factory->Operation = getOperation(Definition->getDeclContext());
+  }
+  return (ProgramFactories[Definition] = std::move(Factory)).get();
+}
+
+const ClassTemplateDecl *TtNNSemanticModel::getNanobindOverloadTemplate() {
+  if (NanobindOverloadTemplate) {
+    return *NanobindOverloadTemplate;
+  }
+
+  // Looked up once in namespace ttnn, so overload arguments are compared by
+  // declaration rather than by name
+  NanobindOverloadTemplate = nullptr;
+  IdentifierTable &Idents = Context->Idents;
+  for (const NamedDecl *Found :
+       Context->getTranslationUnitDecl()->lookup(&Idents.get("ttnn"))) {
+    const auto *NS = dyn_cast<NamespaceDecl>(Found);
+    if (!NS) {
+      continue;
+    }
+    for (const NamedDecl *Member :
+         NS->lookup(&Idents.get(kNanobindOverloadT))) {
+      // The template may be declared elsewhere and re-exported with `using`
+      if (const auto *Template =
+              dyn_cast<ClassTemplateDecl>(Member->getUnderlyingDecl())) {
+        NanobindOverloadTemplate = Template->getCanonicalDecl();
+        return *NanobindOverloadTemplate;
+      }
+    }
+  }
+  return *NanobindOverloadTemplate;
+}
+
+const TtNNBindingCall &TtNNSemanticModel::getBindingCall(const CallExpr &Call) {
+  std::unique_ptr<TtNNBindingCall> &Binding = BindingCalls[&Call];
+  if (Binding) {
+    return *Binding;
+  }
+
+  Binding = std::make_unique<TtNNBindingCall>();
+  Binding->Call = &Call;
+  const ClassTemplateDecl *OverloadTemplate = getNanobindOverloadTemplate();
+  if (!OverloadTemplate) {
+    return *Binding;
+  }
+  // The module, the operation and the doc string come first
+  for (unsigned I = 3, E = Call.getNumArgs(); I < E; ++I) {
+    const Expr *Argument = Call.getArg(I)->IgnoreImplicit();
+    const auto *Spec = dyn_cast_or_null<ClassTemplateSpecializationDecl>(
+        Argument->getType()->getAsCXXRecordDecl());
+    if (Spec && Spec->getSpecializedTemplate()->getCanonicalDecl() ==
+                    OverloadTemplate) {
+      Binding->Overloads.push_back({Argument, getOverloadLambda(*Argument)});
+    }
+  }
+  return *Binding;
+}
+
+void TtNNSemanticModel::indexDeclContext(
+    const DeclContext *DC, llvm::DenseSet<const TtNNOperation *> &Listed) {
+  const SourceManager &SM = Context->getSourceManager();
+  for (const Decl *D : DC->decls()) {
+    if (const auto *NS = dyn_cast<NamespaceDecl>(D)) {
+      if (!SM.isInSystemHeader(NS->getLocation())) {
+        indexDeclContext(NS, Listed);
+      }
+      continue;
+    }
+    if (const auto *Linkage = dyn_cast<LinkageSpecDecl>(D)) {
+      indexDeclContext(Linkage, Listed);
+      continue;
+    }
+    const auto *Named = dyn_cast<NamedDecl>(D);
+    if (!Named || !isa<NamespaceDecl>(DC)) {
+      continue;
+    }
+    const auto *Record = dyn_cast<CXXRecordDecl>(Named);
+    if (Record && !Record->isThisDeclarationADefinition()) {
+      continue;
+    }
+
+    TtNNOperation *Operation =
+        resolveNamespace(cast<NamespaceDecl>(DC)).Operation;
+    if (!Operation) {
+      continue;
+    }
+    bool Found = true;
+    if (std::optional<TtNNTypeKind> Kind = classifyTtNNTypeDecl(*Named)) {
+      switch (*Kind) {
+      case TtNNTypeKind::SpecReturnValue:
+        Operation->SpecReturnValue = cast<TypeAliasDecl>(Named);
+        break;
+      case TtNNTypeKind::TensorReturnValue:
+        Operation->TensorReturnValue = cast<TypeAliasDecl>(Named);
+        break;
+      case TtNNTypeKind::OperationAttributes:
+        Operation->OperationAttributes = Record;
+        break;
+      case TtNNTypeKind::TensorArgs:
+        Operation->TensorArgs = Record;
+        break;
+      }
+    } else if (Record && isDeviceOperation(*Record)) {
+      Operation->DeviceOperations.push_back(Record);
+    } else if (const TtNNProgramFactory *Factory =
+                   Record ? getProgramFactory(*Record) : nullptr) {
+      Operation->ProgramFactories.push_back(Factory);
+      ProgramFactoryIndex->push_back(Factory);
+    } else {
+      Found = false;
+    }
+
+    if (Found && Listed.insert(Operation).second) {
+      OperationIndex->push_back(Operation);
+    }
+  }
+}
+
+void TtNNSemanticModel::indexDeclarations() {
+  OperationIndex.emplace();
+  ProgramFactoryIndex.emplace();
+  llvm::DenseSet<const TtNNOperation *> Listed;
+  indexDeclContext(Context->getTranslationUnitDecl(), Listed);
+}
+
+llvm::ArrayRef<const TtNNOperation *> TtNNSemanticModel::getOperations() {
+  if (!OperationIndex) {
+    indexDeclarations();
+  }
+  return *OperationIndex;
+}
+
+llvm::ArrayRef<const TtNNProgramFactory *>
+TtNNSemanticModel::getProgramFactories() {
+  if (!ProgramFactoryIndex) {
+    indexDeclarations();
+  }
+  return *ProgramFactoryIndex;
+}
+
+void TtNNSemanticModel::indexBindingCalls() {
+  std::vector<const CallExpr *> Calls;
+  BindingCallFinder Finder(Calls);
+  const SourceManager &SM = Context->getSourceManager();
+  for (Decl *D : Context->getTranslationUnitDecl()->decls()) {
+    if (SM.isWrittenInMainFile(SM.getExpansionLoc(D->getLocation()))) {
+      Finder.TraverseDecl(D);
+    }
+  }
+
+  BindingCallIndex.emplace();
+  for (const CallExpr *Call : Calls) {
+    BindingCallIndex->push_back(&getBindingCall(*Call));
+  }
+}
+
+llvm::ArrayRef<const TtNNBindingCall *> TtNNSemanticModel::getBindingCalls() {
+  if (!BindingCallIndex) {
+    indexBindingCalls();
+  }
+  return *BindingCallIndex;
+}
+
+bool TtNNSemanticModel::isOnlyCalled(const FunctionDecl &Function) {
+  if (!ReferencedFunctions) {
+    ReferencedFunctions.emplace();
+    FunctionReferenceFinder(*ReferencedFunctions)
+        .TraverseDecl(Context->getTranslationUnitDecl());
+  }
+  return !ReferencedFunctions->contains(Function.getCanonicalDecl());
+}
+
+} // namespace clang::tidy::ttnn
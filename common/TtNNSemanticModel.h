@@ -0,0 +1,214 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNSEMANTICMODEL_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNSEMANTICMODEL_H_
+
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/AST/ExprCXX.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+struct TtNNProgramFactory;
+
+/// A TTNN operation: the namespace that names it and what the translation
+/// unit declares in that namespace.
+struct TtNNOperation {
+  /// The operation namespace, as its canonical declaration.
+  const NamespaceDecl *Namespace = nullptr;
+  /// The operation name, e.g. `slice`.
+  StringRef Name;
+  /// Set when every enclosing namespace is a category, so \c Name is only
+  /// the innermost one.
+  bool NamedByCategory = false;
+
+  // The declarations below are filled by the operation index, so they are
+  // only complete once getOperations() has been called.
+
+  /// Namespace-level `*DeviceOperation` struct definitions.
+  llvm::SmallVector<const CXXRecordDecl *, 1> DeviceOperations;
+  /// The types-file declarations, as classified by classifyTtNNTypeDecl():
+  /// struct definitions and return value aliases.
+  const CXXRecordDecl *OperationAttributes = nullptr;
+  const CXXRecordDecl *TensorArgs = nullptr;
+  const TypeAliasDecl *SpecReturnValue = nullptr;
+  const TypeAliasDecl *TensorReturnValue = nullptr;
+  /// Namespace-level program factories of the operation.
+  llvm::SmallVector<const TtNNProgramFactory *, 2> ProgramFactories;
+};
+
+/// A program factory: a struct with a static `create` and a nested
+/// `shared_variables_t` or `cached_program_t`.
+struct TtNNProgramFactory {
+  const CXXRecordDecl *Record = nullptr;
+  const TtNNOperation *Operation = nullptr;
+  /// The nested `shared_variables_t` struct or alias, if declared.
+  const NamedDecl *SharedVariables = nullptr;
+  /// The static `create` and `override_runtime_arguments` members, if
+  /// declared.
+  const CXXMethodDecl *Create = nullptr;
+  const CXXMethodDecl *OverrideRuntimeArguments = nullptr;
+};
+
+/// A `bind_registered_operation` call.
+struct TtNNBindingCall {
+  /// A `nanobind_overload_t` argument and the lambda it is constructed with,
+  /// if it is constructed from one.
+  struct Overload {
+    const Expr *Argument = nullptr;
+    const LambdaExpr *Lambda = nullptr;
+  };
+
+  const CallExpr *Call = nullptr;
+  /// The `nanobind_overload_t` arguments after the module, operation and
+  /// doc string, in order.
+  llvm::SmallVector<Overload, 2> Overloads;
+};
+
+/// What a translation unit declares about TTNN operations, shared by every
+/// TTNN check in the run.
+///
+/// The checks used to work the same facts out independently and on every
+/// callback: the operation a namespace names, whether a file is a types
+/// header, whether an alias spells Tensor or TensorSpec, which arguments of a
+/// binding call are overloads. The model answers these once per declaration,
+/// file or call and keeps the answer for the rest of the translation unit.
+///
+/// Nothing is computed up front. Per-declaration queries resolve only what
+/// they are asked about. The operation index, i.e. getOperations() and
+/// getProgramFactories(), walks the namespace-level declarations of the
+/// translation unit outside system headers, whatever the traversal scope,
+/// on first use. getBindingCalls() walks the function bodies of the main
+/// file on first use, and isOnlyCalled() the whole translation unit.
+///
+/// Like `TtNNTypeLocDispatcher`, there is one model per `MatchFinder` and
+/// category namespace list, so checks with the same `CategoryNamespaces` share
+/// it. It learns the translation unit from its own translation unit matcher,
+/// which runs before any check callback queries it, and forgets it at the end
+/// of the translation unit.
+class TtNNSemanticModel : public ast_matchers::MatchFinder::MatchCallback {
+public:
+  /// Attaches the model for \p Finder and \p CategoryNamespaces, creating it
+  /// if needed. The returned pointer keeps the model alive and must be held
+  /// for as long as \p Finder may run.
+  ///
+  /// \p CategoryNamespaces is the value of the `CategoryNamespaces` option
+  /// (local or global): semicolon-separated namespaces that group operations
+  /// rather than name one, so getOperationName() skips them.
+  static std::shared_ptr<TtNNSemanticModel>
+  attach(ast_matchers::MatchFinder *Finder, StringRef CategoryNamespaces);
+
+  void run(const ast_matchers::MatchFinder::MatchResult &Result) override;
+  void onEndOfTranslationUnit() override;
+  StringRef getID() const override;
+
+  /// Returns the operation of the innermost namespace enclosing \p DC, or
+  /// nullptr outside any named namespace. The innermost namespace that is
+  /// not a category names the operation: ttnn::operations::data_movement::
+  /// slice gives `slice`. Without one, the innermost named namespace does.
+  const TtNNOperation *getOperation(const DeclContext *DC);
+
+  /// The name of getOperation(), or an empty name.
+  StringRef getOperationName(const DeclContext *DC) {
+    const TtNNOperation *Operation = getOperation(DC);
+    return Operation ? Operation->Name : StringRef();
+  }
+
+  /// Returns true if \p DC is inside a `ttnn::operations` namespace.
+  bool isInOperationsNamespace(const DeclContext *DC);
+
+  /// Returns true if \p Loc, after macro expansion, is in a
+  /// `*_device_operation_types.hpp` header.
+  bool isInTypesFile(SourceLocation Loc);
+
+  /// Returns true if \p Record is `ttnn::Tensor` or `tt::tt_metal::Tensor`.
+  static bool isTensorRecord(const CXXRecordDecl &Record);
+
+  /// Returns true if \p Record is a `*DeviceOperation` struct.
+  static bool isDeviceOperation(const CXXRecordDecl &Record);
+
+  /// Returns true if \p Alias spells `Tensor` or `TensorSpec`, unqualified
+  /// or as `ttnn::`, with nothing around it.
+  bool isDirectTensorAlias(const TypeAliasDecl &Alias);
+
+  /// Returns the program factory declared by \p Record, or nullptr.
+  const TtNNProgramFactory *getProgramFactory(const CXXRecordDecl &Record);
+
+  /// Returns the canonical declaration of the `ttnn::nanobind_overload_t`
+  /// class template, declared in `ttnn` or re-exported there by a using
+  /// declaration, or nullptr if the translation unit has neither.
+  const ClassTemplateDecl *getNanobindOverloadTemplate();
+
+  /// Classifies the arguments of the `bind_registered_operation` call
+  /// \p Call. An overload argument is a specialization of
+  /// getNanobindOverloadTemplate().
+  const TtNNBindingCall &getBindingCall(const CallExpr &Call);
+
+  /// Every operation declaring something at namespace level in the
+  /// translation unit, in declaration order.
+  llvm::ArrayRef<const TtNNOperation *> getOperations();
+
+  /// Every namespace-level program factory, in declaration order.
+  llvm::ArrayRef<const TtNNProgramFactory *> getProgramFactories();
+
+  /// Every `bind_registered_operation` call in the main file, in order.
+  llvm::ArrayRef<const TtNNBindingCall *> getBindingCalls();
+
+  /// Returns true if the translation unit names \p Function only as the
+  /// callee of calls, i.e. never binds it to a pointer, passes it as a
+  /// callback or names it in a template argument.
+  bool isOnlyCalled(const FunctionDecl &Function);
+
+private:
+  struct ResolvedNamespace {
+    TtNNOperation *Operation = nullptr;
+    bool IsCategory = true;
+  };
+
+  ResolvedNamespace resolveNamespace(const NamespaceDecl *NS);
+  TtNNOperation *getOperationFor(const NamespaceDecl *NS, bool NamedByCategory);
+  void indexDeclarations();
+  void indexDeclContext(const DeclContext *DC,
+                        llvm::DenseSet<const TtNNOperation *> &Listed);
+  void indexBindingCalls();
+
+  llvm::StringSet<> CategoryNamespaces;
+  ASTContext *Context = nullptr;
+
+  // Everything below describes the current translation unit
+  llvm::DenseMap<const NamespaceDecl *, ResolvedNamespace> Namespaces;
+  llvm::DenseMap<const NamespaceDecl *, std::unique_ptr<TtNNOperation>>
+      Operations;
+  llvm::DenseMap<const NamespaceDecl *, bool> OperationsNamespaces;
+  llvm::DenseMap<FileID, bool> TypesFiles;
+  llvm::DenseMap<const TypeAliasDecl *, bool> DirectTensorAliases;
+  llvm::DenseMap<const CXXRecordDecl *, std::unique_ptr<TtNNProgramFactory>>
+      ProgramFactories;
+  llvm::DenseMap<const CallExpr *, std::unique_ptr<TtNNBindingCall>>
+      BindingCalls;
+  std::optional<const ClassTemplateDecl *> NanobindOverloadTemplate;
+
+  std::optional<std::vector<const TtNNOperation *>> OperationIndex;
+  std::optional<std::vector<const TtNNProgramFactory *>> ProgramFactoryIndex;
+  std::optional<std::vector<const TtNNBindingCall *>> BindingCallIndex;
+  // Canonical declarations of the functions named other than as a callee
+  std::optional<llvm::DenseSet<const FunctionDecl *>> ReferencedFunctions;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNSEMANTICMODEL_H_
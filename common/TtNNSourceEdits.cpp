@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNSourceEdits.h"
+#include "clang/Lex/Lexer.h"
+#include "clang/Lex/Token.h"
+
+namespace clang::tidy::ttnn {
+
+std::optional<FixItHint> replaceToken(SourceLocation Loc,
+                                      llvm::StringRef Expected,
+                                      llvm::StringRef Text,
+                                      const SourceManager &SM,
+                                      const LangOptions &LO) {
+  if (Loc.isInvalid() || Loc.isMacroID()) {
+    return std::nullopt;
+  }
+  // Lexes exactly one token; nothing past it is read
+  Token Tok;
+  if (Lexer::getRawToken(Loc, Tok, SM, LO, /*IgnoreWhiteSpace=*/false) ||
+      !Tok.is(tok::raw_identifier) || Tok.getRawIdentifier() != Expected) {
+    return std::nullopt;
+  }
+  return FixItHint::CreateReplacement(
+      CharSourceRange::getCharRange(Loc, Tok.getEndLoc()), Text);
+}
+
+std::optional<FixItHint> replaceTokens(SourceRange Range, llvm::StringRef Text,
+                                       const SourceManager &SM,
+                                       const LangOptions &LO) {
+  if (Range.isInvalid() || Range.getBegin().isMacroID() ||
+      Range.getEnd().isMacroID()) {
+    return std::nullopt;
+  }
+  SourceLocation End = Lexer::getLocForEndOfToken(Range.getEnd(), 0, SM, LO);
+  if (End.isInvalid()) {
+    return std::nullopt;
+  }
+  return FixItHint::CreateReplacement(
+      CharSourceRange::getCharRange(Range.getBegin(), End), Text);
+}
+
+std::optional<FixItHint> removeDeclaration(SourceRange Range,
+                                           const SourceManager &SM,
+                                           const LangOptions &LO) {
+  if (Range.isInvalid() || Range.getBegin().isMacroID() ||
+      Range.getEnd().isMacroID()) {
+    return std::nullopt;
+  }
+
+  SourceLocation End = Lexer::findLocationAfterToken(
+      Range.getEnd(), tok::semi, SM, LO,
+      /*SkipTrailingWhitespaceAndNewLine=*/false);
+  if (End.isInvalid()) {
+    return std::nullopt;
+  }
+
+  auto [FID, BeginOffset] = SM.getDecomposedLoc(Range.getBegin());
+  auto [EndFID, EndOffset] = SM.getDecomposedLoc(End);
+  bool Invalid = false;
+  llvm::StringRef Buffer = SM.getBufferData(FID, &Invalid);
+  if (Invalid || FID != EndFID) {
+    return std::nullopt;
+  }
+
+  // Only the declaration's own lines are looked at
+  size_t LineStart = Buffer.rfind('\n', BeginOffset);
+  LineStart = LineStart == llvm::StringRef::npos ? 0 : LineStart + 1;
+  size_t LineEnd = Buffer.find('\n', EndOffset);
+  LineEnd = LineEnd == llvm::StringRef::npos ? Buffer.size() : LineEnd + 1;
+
+  llvm::StringRef Before = Buffer.slice(LineStart, BeginOffset);
+  llvm::StringRef After = Buffer.slice(EndOffset, LineEnd).trim();
+  if (Before.trim().empty()) {
+    BeginOffset = LineStart;
+  }
+  if (After.empty() || After.starts_with("//")) {
+    EndOffset = LineEnd;
+  }
+
+  SourceLocation FileStart = SM.getLocForStartOfFile(FID);
+  return FixItHint::CreateRemoval(
+      CharSourceRange::getCharRange(FileStart.getLocWithOffset(BeginOffset),
+                                    FileStart.getLocWithOffset(EndOffset)));
+}
+
+std::optional<FixItHint> removeArgument(const Expr &Arg, const Expr &Next,
+                                        const SourceManager &SM,
+                                        const LangOptions &LO) {
+  SourceLocation Begin = Arg.getBeginLoc();
+  SourceLocation NextBegin = Next.getBeginLoc();
+  if (Begin.isInvalid() || NextBegin.isInvalid() || Begin.isMacroID() ||
+      NextBegin.isMacroID() || Arg.getEndLoc().isMacroID()) {
+    return std::nullopt;
+  }
+  // The two must be separated by nothing but a comma
+  if (Lexer::findLocationAfterToken(Arg.getEndLoc(), tok::comma, SM, LO,
+                                    /*SkipTrailingWhitespaceAndNewLine=*/false)
+          .isInvalid()) {
+    return std::nullopt;
+  }
+  return FixItHint::CreateRemoval(
+      CharSourceRange::getCharRange(Begin, NextBegin));
+}
+
+bool makeConstReference(const ParmVarDecl &Param, const SourceManager &SM,
+                        const LangOptions &LO,
+                        llvm::SmallVectorImpl<FixItHint> &FixIts) {
+  const TypeSourceInfo *TSI = Param.getTypeSourceInfo();
+  if (!TSI) {
+    return false;
+  }
+  // The type location covers `std::vector<Tensor>` but not the qualifiers
+  SourceRange Range = TSI->getTypeLoc().getSourceRange();
+  if (Range.isInvalid() || Range.getBegin().isMacroID() ||
+      Range.getEnd().isMacroID()) {
+    return false;
+  }
+  SourceLocation End = Lexer::getLocForEndOfToken(Range.getEnd(), 0, SM, LO);
+  if (End.isInvalid()) {
+    return false;
+  }
+
+  bool IsConst = Param.getType().isLocalConstQualified();
+  if (IsConst) {
+    // A trailing `const` goes before the `&`
+    Token Tok;
+    if (!Lexer::getRawToken(End, Tok, SM, LO, /*IgnoreWhiteSpace=*/true) &&
+        Tok.is(tok::raw_identifier) && Tok.getRawIdentifier() == "const") {
+      End = Tok.getEndLoc();
+    }
+  } else {
+    FixIts.push_back(FixItHint::CreateInsertion(Range.getBegin(), "const "));
+  }
+  FixIts.push_back(FixItHint::CreateInsertion(End, "&"));
+  return true;
+}
+
+} // namespace clang::tidy::ttnn
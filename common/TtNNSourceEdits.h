@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNSOURCEEDITS_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNSOURCEEDITS_H_
+
+// Fix-it construction shared by the checks. Edits are located with Lexer
+// token locations and views of the file buffer: no source text is copied, and
+// the cost of an edit depends on its size, not on the size of the file.
+//
+// Every function returns std::nullopt, or false, when the edit would touch a
+// macro expansion or the source does not look as expected, in which case the
+// diagnostic is reported without that fix.
+
+#include "clang/AST/Decl.h"
+#include "clang/AST/Expr.h"
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <optional>
+
+namespace clang::tidy::ttnn {
+
+/// Replaces the identifier token at \p Loc with \p Text, provided it is
+/// spelled \p Expected.
+std::optional<FixItHint> replaceToken(SourceLocation Loc,
+                                      llvm::StringRef Expected,
+                                      llvm::StringRef Text,
+                                      const SourceManager &SM,
+                                      const LangOptions &LO);
+
+/// Replaces the tokens in \p Range with \p Text.
+std::optional<FixItHint> replaceTokens(SourceRange Range, llvm::StringRef Text,
+                                       const SourceManager &SM,
+                                       const LangOptions &LO);
+
+/// Removes the declaration spanning \p Range together with the `;` after it.
+/// Indentation before it goes too if nothing else precedes it on its line, and
+/// so does the rest of its last line, newline included, if only whitespace or
+/// a `//` comment follows.
+std::optional<FixItHint> removeDeclaration(SourceRange Range,
+                                           const SourceManager &SM,
+                                           const LangOptions &LO);
+
+/// Removes the call argument \p Arg, the comma after it and the whitespace up
+/// to \p Next, which takes its place.
+std::optional<FixItHint> removeArgument(const Expr &Arg, const Expr &Next,
+                                        const SourceManager &SM,
+                                        const LangOptions &LO);
+
+/// Makes the by-value parameter \p Param a `const&` one: `Tensor x` and
+/// `const Tensor x` become `const Tensor& x`, `Tensor const x` becomes
+/// `Tensor const& x`. Appends the one or two insertions to \p FixIts.
+bool makeConstReference(const ParmVarDecl &Param, const SourceManager &SM,
+                        const LangOptions &LO,
+                        llvm::SmallVectorImpl<FixItHint> &FixIts);
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNSOURCEEDITS_H_
@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNStatistics.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+// Keys in sorted order, so files of different runs diff cleanly
+template <typename T>
+std::vector<llvm::StringRef> getSortedKeys(const llvm::StringMap<T> &Map) {
+  std::vector<llvm::StringRef> Keys;
+  Keys.reserve(Map.size());
+  for (const auto &Entry : Map) {
+    Keys.push_back(Entry.getKey());
+  }
+  llvm::sort(Keys);
+  return Keys;
+}
+
+} // namespace
+
+llvm::Error TtNNCheckStatistics::flush() {
+  auto Reset = llvm::make_scope_exit([this] {
+    MainFile.clear();
+    Counters.clear();
+    Timers.clear();
+  });
+  if (MainFile.empty()) {
+    return llvm::Error::success();
+  }
+
+  if (std::error_code EC = llvm::sys::fs::create_directories(Directory)) {
+    return llvm::createFileError(Directory, EC);
+  }
+
+  llvm::SmallString<256> Target(Directory);
+  llvm::sys::path::append(Target, Check + "-" +
+                                      llvm::utohexstr(llvm::xxHash64(MainFile)) +
+                                      ".json");
+  llvm::SmallString<256> TempPath;
+  int FD;
+  if (std::error_code EC = llvm::sys::fs::createUniqueFile(
+          llvm::Twine(Target) + "-%%%%%%%%.tmp", FD, TempPath)) {
+    return llvm::createFileError(Target, EC);
+  }
+
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    llvm::json::OStream J(OS, /*IndentSize=*/2);
+    J.object([&] {
+      J.attribute("check", Check);
+      J.attribute("file", MainFile);
+      J.attributeObject("stages", [&] {
+        for (llvm::StringRef Stage : getSortedKeys(Counters)) {
+          J.attribute(Stage, Counters.lookup(Stage));
+        }
+      });
+      J.attributeObject("timers", [&] {
+        for (llvm::StringRef Path : getSortedKeys(Timers)) {
+          const Timer &T = Timers.find(Path)->second;
+          J.attributeObject(Path, [&] {
+            J.attribute("count", T.Count);
+            J.attribute("nanoseconds", T.Nanoseconds);
+          });
+        }
+      });
+    });
+    OS << '\n';
+    OS.close();
+    if (OS.has_error()) {
+      std::error_code EC = OS.error();
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return llvm::createFileError(TempPath, EC);
+    }
+  }
+
+  // The same translation unit analyzed again replaces its previous file
+  if (std::error_code EC = llvm::sys::fs::rename(TempPath, Target)) {
+    llvm::sys::fs::remove(TempPath);
+    return llvm::createFileError(Target, EC);
+  }
+  return llvm::Error::success();
+}
+
+} // namespace clang::tidy::ttnn
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNSTATISTICS_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNSTATISTICS_H_
+
+// Per-translation-unit instrumentation of a check's callbacks: how often each
+// filter stage was reached and how long the fix-generation paths took. Only
+// exists when the `StatisticsDirectory` option is set; the checks reach it
+// through TtNNCheck::countStage() and TtNNCheck::timePath(), which do nothing
+// otherwise.
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace clang::tidy::ttnn {
+
+/// Counters and timers of one check over one translation unit.
+class TtNNCheckStatistics {
+public:
+  TtNNCheckStatistics(std::string Check, std::string Directory)
+      : Check(std::move(Check)), Directory(std::move(Directory)) {}
+
+  /// Sets the main file of the translation unit being analyzed.
+  void setMainFile(std::string Path) { MainFile = std::move(Path); }
+
+  void count(llvm::StringRef Stage) { ++Counters[Stage]; }
+
+  void addTime(llvm::StringRef Path, std::chrono::nanoseconds Elapsed) {
+    Timer &T = Timers[Path];
+    ++T.Count;
+    T.Nanoseconds += Elapsed.count();
+  }
+
+  /// Writes the statistics of the current translation unit to
+  /// `<Directory>/<check>-<hash of main file>.json` and resets them. Writes
+  /// nothing if no main file was seen.
+  llvm::Error flush();
+
+private:
+  struct Timer {
+    uint64_t Count = 0;
+    uint64_t Nanoseconds = 0;
+  };
+
+  const std::string Check;
+  const std::string Directory;
+  std::string MainFile;
+  llvm::StringMap<uint64_t> Counters;
+  llvm::StringMap<Timer> Timers;
+};
+
+/// Adds the time from construction to destruction to a path of a
+/// TtNNCheckStatistics. Does not read the clock if it has none.
+class TtNNStatisticsTimer {
+public:
+  TtNNStatisticsTimer(TtNNCheckStatistics *Statistics, llvm::StringRef Path)
+      : Statistics(Statistics), Path(Path) {
+    if (Statistics) {
+      Start = std::chrono::steady_clock::now();
+    }
+  }
+  TtNNStatisticsTimer(const TtNNStatisticsTimer &) = delete;
+  TtNNStatisticsTimer &operator=(const TtNNStatisticsTimer &) = delete;
+
+  ~TtNNStatisticsTimer() {
+    if (Statistics) {
+      Statistics->addTime(Path,
+                          std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - Start));
+    }
+  }
+
+private:
+  TtNNCheckStatistics *const Statistics;
+  const llvm::StringRef Path;
+  std::chrono::steady_clock::time_point Start;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNSTATISTICS_H_
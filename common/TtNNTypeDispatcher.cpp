@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNTypeDispatcher.h"
+#include "TtNNFinderShared.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/ASTMatchers/ASTMatchers.h"
+
+using namespace clang::ast_matchers;
+
+namespace clang::tidy::ttnn {
+
+std::optional<TtNNTypeKind> classifyTtNNTypeDecl(const NamedDecl &D) {
+  if (!isa<NamespaceDecl>(D.getDeclContext())) {
+    return std::nullopt;
+  }
+
+  llvm::StringRef Name = D.getName();
+  if (isa<TypeAliasDecl>(D)) {
+    if (Name == kSpecReturnValueT) {
+      return TtNNTypeKind::SpecReturnValue;
+    }
+    if (Name == kTensorReturnValueT) {
+      return TtNNTypeKind::TensorReturnValue;
+    }
+    return std::nullopt;
+  }
+
+  if (isa<CXXRecordDecl>(D)) {
+    if (Name == kOperationAttributesT) {
+      return TtNNTypeKind::OperationAttributes;
+    }
+    if (Name == kTensorArgsT) {
+      return TtNNTypeKind::TensorArgs;
+    }
+  }
+  return std::nullopt;
+}
+
+std::shared_ptr<TtNNTypeLocDispatcher>
+TtNNTypeLocDispatcher::subscribe(MatchFinder *Finder,
+                                 llvm::ArrayRef<TtNNTypeKind> Kinds,
+                                 TtNNTypeLocHandler *Handler,
+                                 bool SpelledInSourceOnly) {
+  auto Create = [&] {
+    // The traversal kind is read when the matcher is added
+    auto Created = std::make_shared<TtNNTypeLocDispatcher>();
+    Created->SpelledInSourceOnly = SpelledInSourceOnly;
+
+    // Match the written (elaborated) type name so the range includes the
+    // qualifier. hasDeclaration looks through UsingType, so names brought in
+    // with a using-declaration resolve to the original declaration. Usages
+    // are only rewritten outside types headers, so the main file is the only
+    // file of interest whatever the traversal scope.
+    Finder->addMatcher(
+        elaboratedTypeLoc(
+            isExpansionInMainFile(),
+            hasNamedTypeLoc(loc(qualType(hasDeclaration(
+                namedDecl(hasAnyName(kSpecReturnValueT, kTensorReturnValueT,
+                                     kOperationAttributesT, kTensorArgsT),
+                          hasDeclContext(namespaceDecl()))
+                    .bind("ttnn_type_decl"))))))
+            .bind("ttnn_type_loc"),
+        Created.get());
+    return Created;
+  };
+
+  // One dispatcher per MatchFinder (i.e. per translation unit) and traversal
+  // mode
+  std::shared_ptr<TtNNTypeLocDispatcher> Dispatcher =
+      getFinderShared<TtNNTypeLocDispatcher>(Finder, SpelledInSourceOnly,
+                                             Create);
+
+  unsigned KindMask = 0;
+  for (TtNNTypeKind Kind : Kinds) {
+    KindMask |= static_cast<unsigned>(Kind);
+  }
+  Dispatcher->Subscribers.push_back({KindMask, Handler});
+  return Dispatcher;
+}
+
+void TtNNTypeLocDispatcher::run(const MatchFinder::MatchResult &Result) {
+  const auto *TL = Result.Nodes.getNodeAs<TypeLoc>("ttnn_type_loc");
+  const auto *Decl = Result.Nodes.getNodeAs<NamedDecl>("ttnn_type_decl");
+  if (!TL || !Decl) {
+    return;
+  }
+
+  std::optional<TtNNTypeKind> Kind = classifyTtNNTypeDecl(*Decl);
+  if (!Kind) {
+    return;
+  }
+
+  for (const Subscriber &S : Subscribers) {
+    if (S.KindMask & static_cast<unsigned>(*Kind)) {
+      S.Handler->checkTypeLoc(*TL, *Decl, *Kind, Result);
+    }
+  }
+}
+
+StringRef TtNNTypeLocDispatcher::getID() const {
+  return "ttnn-type-dispatch";
+}
+
+std::optional<TraversalKind>
+TtNNTypeLocDispatcher::getCheckTraversalKind() const {
+  if (SpelledInSourceOnly) {
+    return TK_IgnoreUnlessSpelledInSource;
+  }
+  return std::nullopt;
+}
+
+} // namespace clang::tidy::ttnn
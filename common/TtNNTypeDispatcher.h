@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNTYPEDISPATCHER_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNTYPEDISPATCHER_H_
+
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "common/TtNNNames.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <memory>
+#include <optional>
+
+namespace clang::tidy::ttnn {
+
+/// The TTNN types a written type name can resolve to.
+enum class TtNNTypeKind : unsigned {
+  SpecReturnValue = 1u << 0,     // alias `spec_return_value_t`
+  TensorReturnValue = 1u << 1,   // alias `tensor_return_value_t`
+  OperationAttributes = 1u << 2, // struct `operation_attributes_t`
+  TensorArgs = 1u << 3,          // struct `tensor_args_t`
+};
+
+/// Classifies the declaration a type name resolves to.
+///
+/// Return value aliases must be namespace-level `TypeAliasDecl`s and the
+/// operation structs must be namespace-level record definitions; the
+/// same names declared inside a `DeviceOperation` struct are not classified.
+std::optional<TtNNTypeKind> classifyTtNNTypeDecl(const NamedDecl &D);
+
+/// Receives the type locations dispatched by `TtNNTypeLocDispatcher`.
+class TtNNTypeLocHandler {
+public:
+  virtual ~TtNNTypeLocHandler() = default;
+
+  /// Called once for each written type name that resolves to a TTNN type
+  /// of a kind the handler subscribed to. \p TL covers the whole spelling,
+  /// including any namespace qualifier.
+  virtual void checkTypeLoc(const TypeLoc &TL, const NamedDecl &Decl,
+                            TtNNTypeKind Kind,
+                            const ast_matchers::MatchFinder::MatchResult &Result) = 0;
+};
+
+/// Shared type location matcher for all TTNN checks.
+///
+/// Several checks need to look at written type names. Rather than each one
+/// registering its own `typeLoc()` matcher, the first subscriber on a
+/// `MatchFinder` registers a single, declaration-filtered matcher and every
+/// hit is classified once and forwarded to the interested checks. Checks that
+/// are not enabled never subscribe, so they cost nothing.
+///
+/// Subscribers that only want type names spelled in the source share a second
+/// dispatcher whose matcher runs with `TK_IgnoreUnlessSpelledInSource`, so the
+/// copies of a type name in template instantiations are not matched at all.
+class TtNNTypeLocDispatcher : public ast_matchers::MatchFinder::MatchCallback {
+public:
+  /// Subscribes \p Handler to the given type kinds on \p Finder, creating the
+  /// dispatcher for that finder and traversal mode if needed. The returned
+  /// pointer keeps the dispatcher alive and must be held for as long as
+  /// \p Finder may run.
+  static std::shared_ptr<TtNNTypeLocDispatcher>
+  subscribe(ast_matchers::MatchFinder *Finder,
+            llvm::ArrayRef<TtNNTypeKind> Kinds, TtNNTypeLocHandler *Handler,
+            bool SpelledInSourceOnly = false);
+
+  void run(const ast_matchers::MatchFinder::MatchResult &Result) override;
+  StringRef getID() const override;
+  std::optional<TraversalKind> getCheckTraversalKind() const override;
+
+private:
+  struct Subscriber {
+    unsigned KindMask;
+    TtNNTypeLocHandler *Handler;
+  };
+
+  bool SpelledInSourceOnly = false;
+  llvm::SmallVector<Subscriber, 4> Subscribers;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_COMMON_TTNNTYPEDISPATCHER_H_
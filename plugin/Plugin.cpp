@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "clang-tidy/ClangTidyModule.h"
+#include "clang-tidy/ClangTidyModuleRegistry.h"
+#include "common/TtNNNames.h"
+#include "ttnn-nanobind-lambda-by-value/TtNNNanobindLambdaByValueCheck.h"
+#include "ttnn-nanobind-overload/TtNNNanobindOverloadCheck.h"
+#include "ttnn-operation-type-naming/TtNNOperationTypeNamingCheck.h"
+#include "ttnn-program-factory-runtime-args/TtNNProgramFactoryRuntimeArgsCheck.h"
+#include "ttnn-reflection-program-hash/TtNNReflectionProgramHashCheck.h"
+#include "ttnn-return-value-type-alias/TtNNReturnValueTypeAliasCheck.h"
+#include "ttnn-tensor-pass-by-value/TtNNTensorPassByValueCheck.h"
+
+using namespace clang::tidy;
+
+namespace clang::tidy::ttnn {
+
+class TtNNModule : public ClangTidyModule {
+public:
+  void addCheckFactories(ClangTidyCheckFactories &CheckFactories) override {
+    // Names come from the trigger table, which ttnn-tidy's pre-filter reads
+    CheckFactories.registerCheck<TtNNNanobindOverloadCheck>(
+        kNanobindOverloadCheckName);
+    CheckFactories.registerCheck<TtNNReturnValueTypeAliasCheck>(
+        kReturnValueTypeAliasCheckName);
+    CheckFactories.registerCheck<TtNNOperationTypeNamingCheck>(
+        kOperationTypeNamingCheckName);
+    CheckFactories.registerCheck<TtNNTensorPassByValueCheck>(
+        kTensorPassByValueCheckName);
+    CheckFactories.registerCheck<TtNNReflectionProgramHashCheck>(
+        kReflectionProgramHashCheckName);
+    CheckFactories.registerCheck<TtNNNanobindLambdaByValueCheck>(
+        kNanobindLambdaByValueCheckName);
+    CheckFactories.registerCheck<TtNNProgramFactoryRuntimeArgsCheck>(
+        kProgramFactoryRuntimeArgsCheckName);
+  }
+};
+
+} // namespace clang::tidy::ttnn
+
+// Register the module
+static ClangTidyModuleRegistry::Add<clang::tidy::ttnn::TtNNModule> X(
+    "ttnn-module", "Adds TTNN-specific clang-tidy checks.");
+
+// This anchor is used to force the linker to link in the generated object file
+// and thus register the module.
+volatile int TtNNModuleAnchorSource = 0;
@@ -0,0 +1,329 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Applies the compact replacements files written by `ttnn-tidy
+// -export-replacements`:
+//
+//   ttnn-tidy -p build -export-replacements=/tmp/fixes/all.ttnnfix
+//   ttnn-apply-fixes /tmp/fixes
+//
+// Inputs are memory-mapped and parsed in place. Replacements are grouped by
+// file; each file is then deduplicated, checked for conflicting edits and for
+// changes since it was analyzed, and rewritten once, all in parallel. Every
+// file is written to a temporary file next to it and renamed over it, so an
+// interrupted run never leaves a partially edited file behind. A file with
+// conflicting edits is left alone, as clang-apply-replacements does.
+
+#include "common/TtNNReplacements.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace clang::tidy::ttnn;
+
+namespace {
+
+llvm::cl::OptionCategory ApplyFixesCategory("ttnn-apply-fixes options");
+
+llvm::cl::list<std::string>
+    Inputs(llvm::cl::Positional, llvm::cl::OneOrMore,
+           llvm::cl::desc("<replacements file or directory>..."),
+           llvm::cl::cat(ApplyFixesCategory));
+
+llvm::cl::opt<unsigned>
+    Jobs("j", llvm::cl::desc("Number of threads (default: all cores)"),
+         llvm::cl::init(0), llvm::cl::cat(ApplyFixesCategory));
+
+llvm::cl::opt<bool>
+    DryRun("dry-run",
+           llvm::cl::desc("Check the replacements without writing any file"),
+           llvm::cl::cat(ApplyFixesCategory));
+
+/// A replacement whose text points into a mapped input.
+struct Edit {
+  uint32_t Offset;
+  uint32_t Length;
+  llvm::StringRef Text;
+
+  bool operator<(const Edit &Other) const {
+    return std::tie(Offset, Length, Text) <
+           std::tie(Other.Offset, Other.Length, Other.Text);
+  }
+  bool operator==(const Edit &Other) const {
+    return std::tie(Offset, Length, Text) ==
+           std::tie(Other.Offset, Other.Length, Other.Text);
+  }
+};
+
+/// Everything the inputs want done to one file.
+struct FileEdits {
+  std::string Path;
+  uint64_t Hash = 0;
+  bool HashMismatch = false; // inputs analyzed different versions
+  std::vector<Edit> Edits;
+};
+
+std::mutex OutputMutex;
+
+void error(const llvm::Twine &Message) {
+  std::lock_guard<std::mutex> Lock(OutputMutex);
+  llvm::WithColor::error() << Message << '\n';
+}
+
+/// Runs \p Body for every index below \p Count on \p Threads threads.
+template <typename Fn>
+void parallelFor(size_t Count, unsigned Threads, Fn Body) {
+  std::atomic<size_t> Next{0};
+  std::vector<std::thread> Workers;
+  for (unsigned W = 0, E = std::max(1u, Threads); W != E; ++W) {
+    Workers.emplace_back([&] {
+      for (size_t I = Next++; I < Count; I = Next++) {
+        Body(I);
+      }
+    });
+  }
+  for (std::thread &Worker : Workers) {
+    Worker.join();
+  }
+}
+
+bool collectInputs(std::vector<std::string> &Files) {
+  for (const std::string &Input : Inputs) {
+    if (!llvm::sys::fs::is_directory(Input)) {
+      Files.push_back(Input);
+      continue;
+    }
+    std::error_code EC;
+    for (llvm::sys::fs::directory_iterator It(Input, EC), End;
+         It != End && !EC; It.increment(EC)) {
+      if (llvm::sys::path::extension(It->path()) == ".ttnnfix") {
+        Files.push_back(It->path());
+      }
+    }
+    if (EC) {
+      error(Input + ": " + EC.message());
+      return false;
+    }
+  }
+  // Sorted so messages do not depend on directory order
+  llvm::sort(Files);
+  return true;
+}
+
+/// Returns the contents of \p File with \p Edits applied, or an error message
+/// if they cannot be applied. \p Edits must be sorted.
+llvm::Expected<std::string> applyEdits(const FileEdits &File,
+                                       llvm::StringRef Content) {
+  auto Fail = [&](const llvm::Twine &Message) {
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   File.Path + ": " + Message);
+  };
+  if (File.HashMismatch) {
+    return Fail("replacements were computed from different versions of the "
+                "file; not applied");
+  }
+  if (File.Hash && getReplacementsContentHash(Content) != File.Hash) {
+    return Fail("file changed since it was analyzed; not applied");
+  }
+
+  size_t Size = Content.size();
+  for (const Edit &E : File.Edits) {
+    Size += E.Text.size();
+  }
+  std::string Result;
+  Result.reserve(Size);
+
+  const Edit *Previous = nullptr;
+  size_t Pos = 0;
+  for (const Edit &E : File.Edits) {
+    if (size_t(E.Offset) + E.Length > Content.size()) {
+      return Fail("replacement at offset " + llvm::Twine(E.Offset) +
+                  " is past the end of the file; not applied");
+    }
+    // Sorted by offset and then length, so an overlap or two different
+    // insertions at one place show up between neighbours
+    if (Previous && (E.Offset < Pos || (E.Length == 0 &&
+                                        Previous->Length == 0 &&
+                                        E.Offset == Previous->Offset))) {
+      return Fail("conflicting replacements at offset " +
+                  llvm::Twine(E.Offset) + "; not applied");
+    }
+    Result.append(Content.data() + Pos, E.Offset - Pos);
+    Result.append(E.Text.data(), E.Text.size());
+    Pos = E.Offset + E.Length;
+    Previous = &E;
+  }
+  Result.append(Content.data() + Pos, Content.size() - Pos);
+  return Result;
+}
+
+/// Replaces the contents of \p Path with \p Content, keeping its permissions.
+llvm::Error writeAtomically(llvm::StringRef Path, llvm::StringRef Content) {
+  llvm::ErrorOr<llvm::sys::fs::perms> Permissions =
+      llvm::sys::fs::getPermissions(Path);
+  llvm::SmallString<256> TempPath;
+  int FD;
+  if (std::error_code EC = llvm::sys::fs::createUniqueFile(
+          Path + "-%%%%%%%%.tmp", FD, TempPath)) {
+    return llvm::createFileError(Path, EC);
+  }
+
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << Content;
+    OS.close();
+    if (OS.has_error()) {
+      std::error_code EC = OS.error();
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return llvm::createFileError(TempPath, EC);
+    }
+  }
+
+  if (Permissions) {
+    llvm::sys::fs::setPermissions(TempPath, *Permissions);
+  }
+  if (std::error_code EC = llvm::sys::fs::rename(TempPath, Path)) {
+    llvm::sys::fs::remove(TempPath);
+    return llvm::createFileError(Path, EC);
+  }
+  return llvm::Error::success();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  llvm::InitLLVM X(argc, argv);
+  llvm::cl::HideUnrelatedOptions(ApplyFixesCategory);
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv, "Applies ttnn-tidy compact replacements files\n");
+
+  unsigned Threads =
+      Jobs ? Jobs.getValue()
+           : llvm::hardware_concurrency().compute_thread_count();
+
+  std::vector<std::string> InputFiles;
+  if (!collectInputs(InputFiles)) {
+    return 1;
+  }
+
+  // Large inputs are mapped rather than read; the replacement texts point
+  // into the mappings until the end of the run
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>> Buffers(InputFiles.size());
+  std::vector<CompactReplacements> Parsed(InputFiles.size());
+  std::atomic<bool> InputFailed{false};
+  parallelFor(InputFiles.size(), Threads, [&](size_t I) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+        llvm::MemoryBuffer::getFile(InputFiles[I], /*IsText=*/false,
+                                    /*RequiresNullTerminator=*/false);
+    if (!Buffer) {
+      error(InputFiles[I] + ": " + Buffer.getError().message());
+      InputFailed = true;
+      return;
+    }
+    llvm::Expected<CompactReplacements> Result =
+        readCompactReplacements((*Buffer)->getBuffer(), InputFiles[I]);
+    if (!Result) {
+      error(llvm::toString(Result.takeError()));
+      InputFailed = true;
+      return;
+    }
+    Buffers[I] = std::move(*Buffer);
+    Parsed[I] = std::move(*Result);
+  });
+  if (InputFailed) {
+    return 1;
+  }
+
+  // Group by file. Each input's file table is looked up once, not once per
+  // replacement.
+  llvm::StringMap<unsigned> FileIndices;
+  std::vector<FileEdits> Files;
+  for (const CompactReplacements &Input : Parsed) {
+    std::vector<unsigned> Local;
+    Local.reserve(Input.Files.size());
+    for (const CompactReplacements::File &F : Input.Files) {
+      auto [It, Inserted] = FileIndices.try_emplace(F.Path, Files.size());
+      if (Inserted) {
+        Files.emplace_back();
+        Files.back().Path = std::string(F.Path);
+      }
+      FileEdits &File = Files[It->second];
+      if (!File.Hash) {
+        File.Hash = F.Hash;
+      } else if (F.Hash && F.Hash != File.Hash) {
+        File.HashMismatch = true;
+      }
+      Local.push_back(It->second);
+    }
+    for (const CompactReplacements::Replacement &R : Input.Replacements) {
+      Files[Local[R.File]].Edits.push_back({R.Offset, R.Length, R.Text});
+    }
+  }
+
+  std::atomic<size_t> Applied{0};
+  std::atomic<size_t> Changed{0};
+  std::atomic<size_t> Skipped{0};
+  parallelFor(Files.size(), Threads, [&](size_t I) {
+    FileEdits &File = Files[I];
+    llvm::sort(File.Edits);
+    File.Edits.erase(std::unique(File.Edits.begin(), File.Edits.end()),
+                     File.Edits.end());
+
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Content =
+        llvm::MemoryBuffer::getFile(File.Path, /*IsText=*/false,
+                                    /*RequiresNullTerminator=*/false);
+    if (!Content) {
+      error(File.Path + ": " + Content.getError().message());
+      ++Skipped;
+      return;
+    }
+    llvm::Expected<std::string> Result =
+        applyEdits(File, (*Content)->getBuffer());
+    if (!Result) {
+      error(llvm::toString(Result.takeError()));
+      ++Skipped;
+      return;
+    }
+    if (*Result == (*Content)->getBuffer()) {
+      return;
+    }
+    // The file must not stay mapped while it is replaced
+    Content->reset();
+    if (!DryRun) {
+      if (llvm::Error Err = writeAtomically(File.Path, *Result)) {
+        error(llvm::toString(std::move(Err)));
+        ++Skipped;
+        return;
+      }
+    }
+    Applied += File.Edits.size();
+    ++Changed;
+  });
+
+  llvm::errs() << (DryRun ? "would apply " : "applied ") << Applied
+               << " replacements to " << Changed << " files";
+  if (Skipped) {
+    llvm::errs() << ", " << Skipped << " files skipped";
+  }
+  llvm::errs() << '\n';
+  return Skipped ? 1 : 0;
+}
@@ -0,0 +1,299 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNNanobindLambdaByValueCheck.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/AST/ExprCXX.h"
+#include "clang/AST/TypeLoc.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Lex/Lexer.h"
+#include "common/TtNNNames.h"
+#include "common/TtNNSemanticModel.h"
+#include "common/TtNNSourceEdits.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <optional>
+
+using namespace clang::ast_matchers;
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+enum class ParameterKind {
+  // Nothing the check looks at
+  None,
+  // A Tensor or MemoryConfig: nanobind hands over the C++ object its Python
+  // object wraps, so a by-value parameter copies it
+  BoundClass,
+  // A std::vector: nanobind's caster builds the value and moves it into a
+  // by-value parameter, so only a view saves anything
+  Container
+};
+
+bool isBoundClassRecord(const CXXRecordDecl &Record) {
+  return TtNNSemanticModel::isTensorRecord(Record) ||
+         (Record.getIdentifier() && Record.getName() == kMemoryConfig);
+}
+
+// Returns the type argument of the std::vector \p Record, or a null type
+QualType getVectorElement(const CXXRecordDecl &Record) {
+  const auto *Specialization =
+      dyn_cast<ClassTemplateSpecializationDecl>(&Record);
+  if (!Specialization || !Specialization->isInStdNamespace() ||
+      !Specialization->getIdentifier() ||
+      Specialization->getName() != "vector") {
+    return QualType();
+  }
+  const TemplateArgumentList &Args = Specialization->getTemplateArgs();
+  if (Args.size() == 0 || Args[0].getKind() != TemplateArgument::Type) {
+    return QualType();
+  }
+  return Args[0].getAsType();
+}
+
+ParameterKind classifyParameter(QualType Type) {
+  // References have no record, so only by-value parameters get past here
+  const CXXRecordDecl *Record = Type->getAsCXXRecordDecl();
+  if (!Record) {
+    return ParameterKind::None;
+  }
+  if (isBoundClassRecord(*Record)) {
+    return ParameterKind::BoundClass;
+  }
+  if (!getVectorElement(*Record).isNull()) {
+    return ParameterKind::Container;
+  }
+  return ParameterKind::None;
+}
+
+// Returns true if the operation parameter type \p Target takes a view of
+// \p Element as the template \p ViewType names it, spelled as such or through
+// an alias template of that name. A forwarding parameter, as the registered
+// operation's call operator has, is a reference to the vector and does not.
+bool acceptsView(QualType Target, QualType Element, StringRef ViewType,
+                 const ASTContext &Context) {
+  ViewType.consume_front("::");
+  Target = Target.getNonReferenceType();
+  auto IsView = [&](const TemplateDecl *Template) {
+    return Template && Template->getQualifiedNameAsString() == ViewType;
+  };
+  const auto *Written = Target->getAs<TemplateSpecializationType>();
+  const auto *Specialization =
+      dyn_cast_or_null<ClassTemplateSpecializationDecl>(
+          Target->getAsCXXRecordDecl());
+  if (!Specialization ||
+      (!IsView(Specialization->getSpecializedTemplate()) &&
+       !(Written && IsView(Written->getTemplateName().getAsTemplateDecl())))) {
+    return false;
+  }
+  const TemplateArgumentList &Args = Specialization->getTemplateArgs();
+  return Args.size() != 0 && Args[0].getKind() == TemplateArgument::Type &&
+         Context.hasSameUnqualifiedType(Args[0].getAsType(), Element);
+}
+
+// Returns the element type as written in the `std::vector<T>` type of
+// \p Param, or an empty string if it is spelled through an alias or a macro
+StringRef getWrittenElementType(const ParmVarDecl &Param,
+                                const SourceManager &SM,
+                                const LangOptions &LO) {
+  const TypeSourceInfo *TSI = Param.getTypeSourceInfo();
+  if (!TSI) {
+    return {};
+  }
+  TypeLoc TL = TSI->getTypeLoc().getUnqualifiedLoc();
+  if (auto Elaborated = TL.getAs<ElaboratedTypeLoc>()) {
+    TL = Elaborated.getNamedTypeLoc();
+  }
+  auto Specialization = TL.getAs<TemplateSpecializationTypeLoc>();
+  if (!Specialization || Specialization.getNumArgs() == 0) {
+    return {};
+  }
+  SourceRange Range = Specialization.getArgLoc(0).getSourceRange();
+  if (Range.isInvalid() || Range.getBegin().isMacroID() ||
+      Range.getEnd().isMacroID()) {
+    return {};
+  }
+  return Lexer::getSourceText(CharSourceRange::getTokenRange(Range), SM, LO);
+}
+
+// Returns what an argument of self(...) passes on: a parameter copied into a
+// by-value operation parameter is still only forwarded
+const Expr *getForwardedExpr(const Expr *Arg) {
+  Arg = Arg->IgnoreImplicit();
+  if (const auto *Construct = dyn_cast<CXXConstructExpr>(Arg);
+      Construct && Construct->getNumArgs() == 1 &&
+      Construct->getConstructor()->isCopyOrMoveConstructor()) {
+    Arg = Construct->getArg(0)->IgnoreImplicit();
+  }
+  return Arg;
+}
+
+} // namespace
+
+TtNNNanobindLambdaByValueCheck::TtNNNanobindLambdaByValueCheck(
+    StringRef Name, ClangTidyContext *Context)
+    : TtNNCheck(Name, Context),
+      ContainerViewType(Options.get("ContainerViewType", "")) {}
+
+void TtNNNanobindLambdaByValueCheck::storeOptions(
+    ClangTidyOptions::OptionMap &Opts) {
+  TtNNCheck::storeOptions(Opts);
+  Options.store(Opts, "ContainerViewType", ContainerViewType);
+}
+
+void TtNNNanobindLambdaByValueCheck::registerMatchers(MatchFinder *Finder) {
+  registerSharedMatchers(Finder);
+
+  // The model finds the binding calls in one walk of the main file, so the
+  // check only needs to run once per translation unit
+  Finder->addMatcher(translationUnitDecl().bind("binding_unit"), this);
+}
+
+void TtNNNanobindLambdaByValueCheck::check(
+    const MatchFinder::MatchResult &Result) {
+  if (handleTraversalScope(Result)) {
+    return;
+  }
+  if (!Result.Nodes.getNodeAs<TranslationUnitDecl>("binding_unit")) {
+    return;
+  }
+
+  for (const TtNNBindingCall *Binding : getModel().getBindingCalls()) {
+    countStage("bind_call.callback");
+    for (const TtNNBindingCall::Overload &Overload : Binding->Overloads) {
+      if (Overload.Lambda) {
+        checkLambda(*Overload.Lambda, Result);
+      }
+    }
+  }
+}
+
+void TtNNNanobindLambdaByValueCheck::checkLambda(
+    const LambdaExpr &Lambda, const MatchFinder::MatchResult &Result) {
+  countStage("lambda.callback");
+  const CXXMethodDecl *CallOp = Lambda.getCallOperator();
+  if (Lambda.isGenericLambda() || !CallOp || CallOp->getNumParams() < 2) {
+    countStage("lambda.no_parameters");
+    return;
+  }
+
+  const SourceManager &SM = *Result.SourceManager;
+  const LangOptions &LO = getLangOpts();
+  ASTContext &Context = *Result.Context;
+  const ParmVarDecl *Self = CallOp->getParamDecl(0);
+  const Stmt *Body = Lambda.getBody();
+
+  // Every use of a parameter, the uses that are an argument of self(...) as
+  // is, and the types of the operation parameters those arguments bind to
+  llvm::DenseMap<const ValueDecl *, unsigned> Uses;
+  llvm::DenseMap<const ValueDecl *, unsigned> Forwarded;
+  llvm::DenseMap<const ValueDecl *, llvm::SmallVector<QualType, 1>> Targets;
+  for (const BoundNodes &Use :
+       match(stmt(forEachDescendant(
+                 declRefExpr(to(parmVarDecl())).bind("use"))),
+             *Body, Context)) {
+    ++Uses[Use.getNodeAs<DeclRefExpr>("use")->getDecl()];
+  }
+  auto SelfCalls = match(
+      stmt(forEachDescendant(
+          cxxOperatorCallExpr(hasOverloadedOperatorName("()"),
+                              hasArgument(0, ignoringParenImpCasts(declRefExpr(
+                                                 to(equalsNode(Self))))))
+              .bind("self_call"))),
+      *Body, Context);
+  for (const BoundNodes &Match : SelfCalls) {
+    const auto *Call = Match.getNodeAs<CXXOperatorCallExpr>("self_call");
+    // The call operator is a member, so its parameters start at argument 1
+    const FunctionDecl *Callee = Call->getDirectCallee();
+    for (unsigned I = 1, E = Call->getNumArgs(); I < E; ++I) {
+      const auto *Ref =
+          dyn_cast<DeclRefExpr>(getForwardedExpr(Call->getArg(I)));
+      if (!Ref) {
+        continue;
+      }
+      ++Forwarded[Ref->getDecl()];
+      Targets[Ref->getDecl()].push_back(
+          Callee && I - 1 < Callee->getNumParams()
+              ? Callee->getParamDecl(I - 1)->getType()
+              : QualType());
+    }
+  }
+
+  for (const ParmVarDecl *Param : CallOp->parameters().drop_front()) {
+    ParameterKind Kind = classifyParameter(Param->getType());
+    if (Kind == ParameterKind::None) {
+      continue;
+    }
+    countStage("parameter.callback");
+    unsigned Count = Uses.lookup(Param);
+    if (Count == 0 || Count != Forwarded.lookup(Param)) {
+      countStage("parameter.not_only_forwarded");
+      continue;
+    }
+
+    const TypeSourceInfo *TSI = Param->getTypeSourceInfo();
+    StringRef WrittenType =
+        TSI ? Lexer::getSourceText(CharSourceRange::getTokenRange(
+                                       TSI->getTypeLoc().getSourceRange()),
+                                   SM, LO)
+            : StringRef();
+    if (WrittenType.empty()) {
+      countStage("parameter.no_spelling");
+      continue;
+    }
+
+    auto Timer = timePath("fix.parameter_type");
+    std::string Replacement;
+    llvm::SmallVector<FixItHint, 2> FixIts;
+    if (Kind == ParameterKind::Container) {
+      // A vector is only worth reporting with the view fix, and only where
+      // every self(...) it is passed to takes that view; an operation taking
+      // the vector would not compile
+      QualType ElementType =
+          getVectorElement(*Param->getType()->getAsCXXRecordDecl());
+      StringRef Element;
+      if (!ContainerViewType.empty() &&
+          llvm::all_of(Targets.lookup(Param), [&](QualType Target) {
+            return !Target.isNull() &&
+                   acceptsView(Target, ElementType, ContainerViewType,
+                               Context);
+          })) {
+        Element = getWrittenElementType(*Param, SM, LO);
+      }
+      std::optional<FixItHint> FixIt;
+      if (!Element.empty()) {
+        Replacement = ContainerViewType + "<const " + Element.str() + ">";
+        FixIt = replaceTokens(TSI->getTypeLoc().getSourceRange(), Replacement,
+                              SM, LO);
+      }
+      if (!FixIt) {
+        countStage("parameter.only_moved");
+        continue;
+      }
+      FixIts.push_back(*FixIt);
+    } else {
+      Replacement = "const " + WrittenType.str() + "&";
+      makeConstReference(*Param, SM, LO, FixIts);
+    }
+
+    countStage("parameter.reported");
+    report(Param->getLocation(),
+           Kind == ParameterKind::BoundClass
+               ? "binding lambda parameter '%0' copies the object its Python "
+                 "argument wraps on every call but is only passed to "
+                 "self(...); take it as '%1'"
+               : "binding lambda parameter '%0' is move-constructed from "
+                 "nanobind's converted argument on every call but is only "
+                 "passed to self(...), which takes a view; take it as '%1'",
+           {Param->getName(), Replacement}, FixIts, SM);
+  }
+}
+
+} // namespace clang::tidy::ttnn
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_TTNN_NANOBIND_LAMBDA_BY_VALUE_CHECK_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_TTNN_NANOBIND_LAMBDA_BY_VALUE_CHECK_H_
+
+#include "clang-tidy/ClangTidy.h"
+#include "clang-tidy/ClangTidyCheck.h"
+#include "common/TtNNCheck.h"
+
+#include <string>
+
+namespace clang::tidy::ttnn {
+
+/// Flags binding lambda parameters taken by value only to be handed to the
+/// operation.
+///
+/// The lambdas of the `nanobind_overload_t` arguments of
+/// `bind_registered_operation` calls run on every call from Python. What a
+/// by-value parameter costs depends on nanobind's caster. A bound class,
+/// `Tensor` or `MemoryConfig`, is copied out of the object the Python
+/// argument wraps: reference count increments for a `Tensor`, the shard spec
+/// for a `MemoryConfig`. A `std::optional` or a `std::vector` is built by its
+/// caster in any case and only moved into the parameter.
+///
+/// A bound class parameter is flagged when every use of it in the lambda is
+/// as an argument of a `self(...)` call, and the fix makes it `const&`. A
+/// vector of `T` is flagged the same way only with the `ContainerViewType`
+/// option set, e.g. to `ttsl::Span`, and where every `self(...)` parameter it
+/// is passed to takes that view; the fix makes it that view of `const T`, and
+/// nanobind needs a caster for it. Optionals are left alone.
+///
+/// The binding calls are the main-file ones the shared semantic model finds.
+///
+class TtNNNanobindLambdaByValueCheck : public TtNNCheck {
+public:
+  TtNNNanobindLambdaByValueCheck(StringRef Name, ClangTidyContext *Context);
+  void storeOptions(ClangTidyOptions::OptionMap &Opts) override;
+  void registerMatchers(ast_matchers::MatchFinder *Finder) override;
+  void check(const ast_matchers::MatchFinder::MatchResult &Result) override;
+
+private:
+  void checkLambda(const LambdaExpr &Lambda,
+                   const ast_matchers::MatchFinder::MatchResult &Result);
+
+  const std::string ContainerViewType;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_TTNN_NANOBIND_LAMBDA_BY_VALUE_CHECK_H_
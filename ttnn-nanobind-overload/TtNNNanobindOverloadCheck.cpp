@@ -4,11 +4,15 @@
 
 #include "TtNNNanobindOverloadCheck.h"
 #include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/AST/TypeLoc.h"
 #include "clang/ASTMatchers/ASTMatchFinder.h"
 #include "clang/ASTMatchers/ASTMatchers.h"
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Lex/Lexer.h"
+#include "common/TtNNNames.h"
+#include "common/TtNNSourceEdits.h"
 
 using namespace clang::ast_matchers;
 
@@ -16,29 +20,6 @@ namespace clang::tidy::ttnn {
 
 namespace {
 
-// Helper function to check if an expression is a nanobind_overload_t
-bool isNanobindOverloadTExpr(const clang::Expr *E) {
-  if (!E) {
-    return false;
-  }
-
-  // Simple approach: check if the type name contains "nanobind_overload_t"
-  std::string TypeName = E->getType().getAsString();
-  return TypeName.find("nanobind_overload_t") != std::string::npos;
-}
-
-// Extract the lambda expression from a nanobind_overload_t constructor
-const clang::LambdaExpr *extractLambdaFromOverload(const clang::Expr *OverloadExpr) {
-  const auto *TempExpr = dyn_cast<clang::CXXTemporaryObjectExpr>(OverloadExpr);
-  if (!TempExpr || TempExpr->getNumArgs() < 1) {
-    return nullptr;
-  }
-
-  // First argument should be the lambda
-  const clang::Expr *FirstArg = TempExpr->getArg(0)->IgnoreImplicit();
-  return dyn_cast<clang::LambdaExpr>(FirstArg);
-}
-
 // Find the call to self(...) in the lambda body
 const clang::CallExpr *findSelfCall(const clang::Stmt *Body) {
   if (!Body) {
@@ -180,9 +161,71 @@ bool isSimpleForwardingLambda(const clang::LambdaExpr *Lambda) {
   return true;
 }
 
+// Returns the location of the template name in the type written for a
+// nanobind_overload_t temporary, with or without a namespace qualifier
+clang::SourceLocation getTemplateNameLoc(clang::TypeLoc TL) {
+  if (auto Elaborated = TL.getAs<clang::ElaboratedTypeLoc>()) {
+    TL = Elaborated.getNamedTypeLoc();
+  }
+  if (auto Deduced = TL.getAs<clang::DeducedTemplateSpecializationTypeLoc>()) {
+    return Deduced.getTemplateNameLoc();
+  }
+  if (auto Specialization = TL.getAs<clang::TemplateSpecializationTypeLoc>()) {
+    return Specialization.getTemplateNameLoc();
+  }
+  return {};
+}
+
+// Returns the `using OperationType = ...;` alias the lambda's self parameter
+// is declared with, provided the alias is local to the enclosing function and
+// nothing outside the lambda refers to it, so that it can be removed together
+// with the lambda
+const clang::TypeAliasDecl *
+findRemovableOperationTypeAlias(const clang::LambdaExpr *Lambda,
+                                clang::ASTContext &Context) {
+  const clang::CXXMethodDecl *CallOp = Lambda->getCallOperator();
+  if (!CallOp || CallOp->getNumParams() == 0) {
+    return nullptr;
+  }
+
+  clang::QualType SelfType =
+      CallOp->getParamDecl(0)->getType().getNonReferenceType();
+  const auto *Typedef = SelfType->getAs<clang::TypedefType>();
+  if (!Typedef) {
+    return nullptr;
+  }
+  const auto *Alias = dyn_cast<clang::TypeAliasDecl>(Typedef->getDecl());
+  if (!Alias || Alias->getName() != "OperationType") {
+    return nullptr;
+  }
+
+  const auto *Function =
+      dyn_cast<clang::FunctionDecl>(Alias->getLexicalDeclContext());
+  if (!Function || !Function->hasBody()) {
+    return nullptr;
+  }
+
+  const clang::SourceManager &SM = Context.getSourceManager();
+  clang::SourceRange LambdaRange = Lambda->getSourceRange();
+  auto Uses = match(
+      stmt(forEachDescendant(
+          typeLoc(loc(qualType(hasDeclaration(equalsNode(Alias)))))
+              .bind("use"))),
+      *Function->getBody(), Context);
+  for (const BoundNodes &Use : Uses) {
+    clang::SourceLocation Loc =
+        Use.getNodeAs<clang::TypeLoc>("use")->getBeginLoc();
+    if (SM.isBeforeInTranslationUnit(Loc, LambdaRange.getBegin()) ||
+        SM.isBeforeInTranslationUnit(LambdaRange.getEnd(), Loc)) {
+      return nullptr;
+    }
+  }
+  return Alias;
+}
+
 // Generate fix for a single nanobind_overload_t argument
 void generateFixForOverload(const clang::Expr *OverloadExpr,
-                            const clang::SourceManager &SM,
+                            clang::ASTContext &Context,
                             const clang::LangOptions &LO,
                             clang::DiagnosticBuilder &Diag) {
   if (!OverloadExpr) {
@@ -195,184 +238,102 @@ void generateFixForOverload(const clang::Expr *OverloadExpr,
     return;
   }
 
-  // Get the type source info - this gives us the exact location of the type name
-  clang::TypeSourceInfo *TSI = TempExpr->getTypeSourceInfo();
+  const clang::TypeSourceInfo *TSI = TempExpr->getTypeSourceInfo();
   if (!TSI) {
     return;
   }
 
-  // Get the type location - find "nanobind_overload_t" and replace with "nanobind_arguments_t"
-  clang::SourceLocation TypeStart = TSI->getTypeLoc().getBeginLoc();
-  if (TypeStart.isInvalid()) {
-    return;
-  }
-
-  // Read the source text to find "nanobind_overload_t"
-  const char *TypeData = SM.getCharacterData(TypeStart);
-  if (!TypeData) {
-    return;
-  }
-
-  // Search for "nanobind_overload_t" in the source
-  std::string TypeText(TypeData, std::min(size_t(100), strlen(TypeData)));
-  size_t NanobindPos = TypeText.find("nanobind_overload_t");
-  if (NanobindPos == std::string::npos) {
-    return;
-  }
-
-  // "nanobind_overload_t" is 19 characters
-  // Use CharSourceRange for precise character-level replacement
-  clang::SourceLocation ReplaceStart = TypeStart.getLocWithOffset(NanobindPos);
-  clang::SourceLocation ReplaceEnd = TypeStart.getLocWithOffset(NanobindPos + 19); // one past the end
-
-  // Fix 1: Replace "nanobind_overload_t" with "nanobind_arguments_t"
-  Diag << clang::FixItHint::CreateReplacement(
-      clang::CharSourceRange::getCharRange(ReplaceStart, ReplaceEnd),
-      "nanobind_arguments_t");
-
-  // Fix 2: Remove any "using OperationType = decltype(...);" line before this expression
-  // Search backward from the type start for this pattern
-  clang::SourceLocation SearchLoc = TypeStart;
-  unsigned SearchOffset = SM.getFileOffset(SearchLoc);
-  clang::FileID FID = SM.getFileID(SearchLoc);
-
-  // Get buffer data and search backward for "using OperationType"
-  bool InvalidBuf = false;
-  llvm::StringRef Buffer = SM.getBufferData(FID, &InvalidBuf);
-  if (!InvalidBuf && SearchOffset > 0) {
-    // Search backward up to 500 chars for "using OperationType"
-    size_t SearchStart = (SearchOffset > 500) ? SearchOffset - 500 : 0;
-    std::string SearchRegion = Buffer.substr(SearchStart, SearchOffset - SearchStart).str();
-
-    size_t UsingPos = SearchRegion.rfind("using OperationType");
-    if (UsingPos != std::string::npos) {
-      // Find the start of this line (go back to previous newline)
-      size_t LineStart = SearchRegion.rfind('\n', UsingPos);
-      if (LineStart == std::string::npos) {
-        LineStart = 0;
-      } else {
-        LineStart++; // Skip the newline itself
-      }
-
-      // Find the end of this line (find next newline after UsingPos)
-      size_t LineEnd = SearchRegion.find('\n', UsingPos);
-      if (LineEnd == std::string::npos) {
-        LineEnd = SearchRegion.size();
-      } else {
-        LineEnd++; // Include the newline in removal
-      }
-
-      // Create source locations for the line to remove
-      clang::SourceLocation RemoveLineStart = SM.getLocForStartOfFile(FID).getLocWithOffset(SearchStart + LineStart);
-      clang::SourceLocation RemoveLineEnd = SM.getLocForStartOfFile(FID).getLocWithOffset(SearchStart + LineEnd);
-
-      Diag << clang::FixItHint::CreateRemoval(
-          clang::CharSourceRange::getCharRange(RemoveLineStart, RemoveLineEnd));
-    }
-  }
-
-  // Fix 3: Remove the lambda (first argument) and its trailing comma
+  const clang::SourceManager &SM = Context.getSourceManager();
   const clang::Expr *LambdaArg = TempExpr->getArg(0)->IgnoreImplicit();
   const clang::Expr *NextArg = TempExpr->getArg(1)->IgnoreImplicit();
 
-  if (!LambdaArg || !NextArg) {
-    return;
-  }
-
-  clang::SourceLocation LambdaStart = LambdaArg->getBeginLoc();
-  clang::SourceLocation LambdaEnd = LambdaArg->getEndLoc();
-
-  if (LambdaStart.isInvalid() || LambdaEnd.isInvalid()) {
+  // Fix 1: Replace "nanobind_overload_t" with "nanobind_arguments_t"
+  auto Rename = replaceToken(getTemplateNameLoc(TSI->getTypeLoc()),
+                             kNanobindOverloadT, kNanobindArgumentsT, SM, LO);
+  // Fix 2: Remove the lambda (first argument) and its trailing comma, keeping
+  // the line break and indentation in front of the next argument. The two
+  // fixes only make sense together.
+  auto RemoveLambda = removeArgument(*LambdaArg, *NextArg, SM, LO);
+  if (!Rename || !RemoveLambda) {
     return;
   }
+  Diag << *Rename << *RemoveLambda;
 
-  // Find the comma after the lambda to verify structure
-  clang::SourceLocation CommaLoc = clang::Lexer::findLocationAfterToken(
-      LambdaEnd, clang::tok::comma, SM, LO, false);
-
-  if (CommaLoc.isInvalid()) {
-    return;
+  // Fix 3: Remove the "using OperationType = decltype(...);" the lambda was
+  // declared with, if nothing else uses it
+  if (const auto *Lambda = dyn_cast<clang::LambdaExpr>(LambdaArg)) {
+    if (const auto *Alias = findRemovableOperationTypeAlias(Lambda, Context)) {
+      if (auto RemoveAlias =
+              removeDeclaration(Alias->getSourceRange(), SM, LO)) {
+        Diag << *RemoveAlias;
+      }
+    }
   }
-
-  // Remove from lambda start through the comma
-  // Then skip any whitespace/newlines to align with the next argument
-  clang::SourceLocation NextArgStart = NextArg->getBeginLoc();
-
-  // We want to remove: "lambda_expr," and any whitespace up to next arg
-  // But preserve the newline + indentation of the next arg
-  // So remove from LambdaStart to just before NextArgStart
-  clang::SourceLocation RemoveEnd = NextArgStart.getLocWithOffset(-1);
-
-  Diag << clang::FixItHint::CreateRemoval(
-      clang::SourceRange(LambdaStart, RemoveEnd));
 }
 
 } // namespace
 
 void TtNNNanobindOverloadCheck::registerMatchers(MatchFinder *Finder) {
-  // Match all call expressions - we filter in check()
+  registerSharedMatchers(Finder);
+
+  // Arguments are recognised as specializations of the nanobind_overload_t
+  // class template, so unrelated calls are rejected by the matcher without
+  // printing any type names.
+  auto OverloadArg = expr(hasType(hasUnqualifiedDesugaredType(
+      recordType(hasDeclaration(classTemplateSpecializationDecl(
+          hasSpecializedTemplate(
+              classTemplateDecl(hasName(kNanobindOverloadT)))))))));
+
   Finder->addMatcher(
-      callExpr().bind("bind_call"),
+      callExpr(isExpansionInMainFile(),
+               callee(functionDecl(hasName(kBindRegisteredOperation))),
+               hasAnyArgument(OverloadArg))
+          .bind("bind_call"),
       this);
 }
 
 void TtNNNanobindOverloadCheck::check(
     const MatchFinder::MatchResult &Result) {
+  if (handleTraversalScope(Result)) {
+    return;
+  }
+
   const auto *Call = Result.Nodes.getNodeAs<clang::CallExpr>("bind_call");
   if (!Call) {
     return;
   }
+  countStage("bind_call.callback");
 
-  const clang::SourceManager &SM = *Result.SourceManager;
   const clang::LangOptions &LO = getLangOpts();
 
-  // Only check calls in the main file
-  if (!SM.isInMainFile(Call->getBeginLoc())) {
-    return;
-  }
+  // The model finds the nanobind_overload_t arguments after mod, operation
+  // and doc, and the lambda each one is built from
+  const TtNNBindingCall &Binding = getModel().getBindingCall(*Call);
 
-  // Check if this is a call to bind_registered_operation
-  const clang::FunctionDecl *FD = Call->getDirectCallee();
-  if (!FD) {
-    return;
-  }
-  std::string FuncName = FD->getQualifiedNameAsString();
-  if (FuncName.find("bind_registered_operation") == std::string::npos) {
+  // Only a single overload can be simplified
+  if (Binding.Overloads.size() != 1) {
+    countStage("bind_call.not_single_overload");
     return;
   }
+  const clang::Expr *OverloadToFix = Binding.Overloads.front().Argument;
 
-  // Count nanobind_overload_t arguments and find the one to fix
-  // Arguments start at index 3 (after mod, operation, doc)
-  unsigned int OverloadCount = 0;
-  unsigned int ArgIndex = 3; // Start checking from 4th argument (0-indexed)
-  const clang::Expr *OverloadToFix = nullptr;
-
-  for (unsigned int i = ArgIndex; i < Call->getNumArgs(); ++i) {
-    const clang::Expr *Arg = Call->getArg(i)->IgnoreImplicit();
-    if (isNanobindOverloadTExpr(Arg)) {
-      OverloadCount++;
-      if (!OverloadToFix) {
-        OverloadToFix = Arg;
-      }
-    }
+  // Check if the lambda is a simple forwarding lambda
+  const clang::LambdaExpr *Lambda = Binding.Overloads.front().Lambda;
+  if (!isSimpleForwardingLambda(Lambda)) {
+    // Lambda does argument reordering or transformation - cannot simplify
+    countStage("bind_call.not_simple_forwarding");
+    return;
   }
 
-  // If exactly one overload is found, check if it can be simplified
-  if (OverloadCount == 1 && OverloadToFix) {
-    // Extract the lambda and check if it's a simple forwarding lambda
-    const clang::LambdaExpr *Lambda = extractLambdaFromOverload(OverloadToFix);
-    if (!isSimpleForwardingLambda(Lambda)) {
-      // Lambda does argument reordering or transformation - cannot simplify
-      return;
-    }
+  countStage("bind_call.reported");
+  auto Timer = timePath("fix.replace_overload");
 
-    auto Diag = diag(Call->getBeginLoc(),
-                     "unnecessary use of nanobind_overload_t with a single overload; "
-                     "use nanobind_arguments_t instead");
+  auto Diag = diag(Call->getBeginLoc(),
+                   "unnecessary use of nanobind_overload_t with a single overload; "
+                   "use nanobind_arguments_t instead");
 
-    // Generate the auto-fix
-    generateFixForOverload(OverloadToFix, SM, LO, Diag);
-  }
+  // Generate the auto-fix
+  generateFixForOverload(OverloadToFix, *Result.Context, LO, Diag);
 }
 
 } // namespace clang::tidy::ttnn
@@ -7,6 +7,7 @@
 
 #include "clang-tidy/ClangTidy.h"
 #include "clang-tidy/ClangTidyCheck.h"
+#include "common/TtNNCheck.h"
 
 namespace clang::tidy::ttnn {
 
@@ -18,10 +19,10 @@ namespace clang::tidy::ttnn {
 ///
 /// For the user-facing documentation see:
 /// https://clang.llvm.org/extra/clang-tidy/checks/ttnn/nanobind-unnecessary-overload.html
-class TtNNNanobindOverloadCheck : public ClangTidyCheck {
+class TtNNNanobindOverloadCheck : public TtNNCheck {
 public:
   TtNNNanobindOverloadCheck(StringRef Name, ClangTidyContext *Context)
-      : ClangTidyCheck(Name, Context) {}
+      : TtNNCheck(Name, Context) {}
   void registerMatchers(ast_matchers::MatchFinder *Finder) override;
   void check(const ast_matchers::MatchFinder::MatchResult &Result) override;
 };
@@ -10,309 +10,255 @@
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Lex/Lexer.h"
-
-#include <cctype>
+#include "common/TtNNSourceEdits.h"
 
 using namespace clang::ast_matchers;
 
 namespace clang::tidy::ttnn {
 
-namespace {
-
-// Target struct names that should be renamed
-constexpr const char *kOperationAttributesT = "operation_attributes_t";
-constexpr const char *kTensorArgsT = "tensor_args_t";
-
-// Check if the file is a types file (*_device_operation_types.hpp)
-bool isTypesFile(llvm::StringRef Filename) {
-  return Filename.ends_with("_device_operation_types.hpp");
-}
-
-// Convert snake_case or lowercase to PascalCase
-// e.g., "slice" -> "Slice", "conv2d" -> "Conv2d", "batch_norm" -> "BatchNorm"
-std::string toPascalCase(llvm::StringRef Name) {
-  std::string Result;
-  bool CapitalizeNext = true;
-
-  for (char C : Name) {
-    if (C == '_') {
-      CapitalizeNext = true;
-    } else {
-      if (CapitalizeNext) {
-        Result += std::toupper(static_cast<unsigned char>(C));
-        CapitalizeNext = false;
-      } else {
-        Result += C;
-      }
-    }
-  }
+TtNNOperationTypeNamingCheck::TtNNOperationTypeNamingCheck(
+    StringRef Name, ClangTidyContext *Context)
+    : TtNNCheck(Name, Context),
+      IndexDirectory(Options.get("IndexDirectory", "")) {}
 
-  return Result;
+void TtNNOperationTypeNamingCheck::storeOptions(
+    ClangTidyOptions::OptionMap &Opts) {
+  TtNNCheck::storeOptions(Opts);
+  Options.store(Opts, "IndexDirectory", IndexDirectory);
 }
 
-// Extract the operation name from the namespace context
-// Returns the innermost namespace name that's not "operations", "data_movement", etc.
-std::string extractOperationName(const clang::DeclContext *DC) {
-  // Collect namespace names from innermost to outermost
-  std::vector<std::string> NamespaceNames;
-
-  while (DC) {
-    if (const auto *NS = dyn_cast<clang::NamespaceDecl>(DC)) {
-      std::string NSName = NS->getNameAsString();
-      if (!NSName.empty()) {
-        NamespaceNames.push_back(NSName);
-      }
-    }
-    DC = DC->getParent();
+void TtNNOperationTypeNamingCheck::registerMatchers(MatchFinder *Finder) {
+  if (!IndexDirectory.empty()) {
+    // Index mode: headers are indexed as well, so the traversal scope is left
+    // alone and every non-system file is considered.
+    attachModel(Finder);
+    Finder->addMatcher(translationUnitDecl().bind("index_translation_unit"),
+                       this);
+    Finder->addMatcher(
+        cxxRecordDecl(unless(isExpansionInSystemHeader()), isDefinition(),
+                      hasAnyName(kOperationAttributesT, kTensorArgsT),
+                      hasDeclContext(namespaceDecl()))
+            .bind("index_struct_decl"),
+        this);
+    Finder->addMatcher(
+        elaboratedTypeLoc(
+            unless(isExpansionInSystemHeader()),
+            hasNamedTypeLoc(loc(qualType(hasDeclaration(
+                cxxRecordDecl(hasAnyName(kOperationAttributesT, kTensorArgsT),
+                              hasDeclContext(namespaceDecl()))
+                    .bind("index_type_decl"))))))
+            .bind("index_type_loc"),
+        this);
+    return;
   }
 
-  // The innermost namespace should be the operation name
-  // Typical pattern: ttnn::operations::<category>::<operation>
-  // e.g., ttnn::operations::data_movement::slice
-  // We want "slice"
-  if (!NamespaceNames.empty()) {
-    // Skip common namespace names to find the actual operation
-    static const std::set<std::string> CommonNames = {
-        "ttnn", "operations", "data_movement", "eltwise", "binary", "unary",
-        "reduction", "matmul", "conv", "pool", "normalization", "transformer",
-        "embedding", "loss", "kv_cache", "ccl", "moreh", "experimental",
-        "creation", "copy", "reshape_common", "reshape_on_device", "program"};
-
-    // Return the first (innermost) namespace that's not a common category
-    for (const auto &Name : NamespaceNames) {
-      if (CommonNames.find(Name) == CommonNames.end()) {
-        return Name;
-      }
-    }
+  registerSharedMatchers(Finder);
 
-    // Fallback: just use the innermost namespace
-    return NamespaceNames[0];
-  }
+  // Case 1: Match struct/class definitions with the target names (for renaming in types files)
+  Finder->addMatcher(
+      cxxRecordDecl(isExpansionInAnalyzedFile(getTraversalScope()),
+                    isDefinition(),
+                    anyOf(hasName(kOperationAttributesT), hasName(kTensorArgsT)))
+          .bind("struct_decl"),
+      this);
 
-  return "";
+  // Case 2: Type usages (for updating references to the renamed types) arrive
+  // through the shared type location dispatcher, see checkTypeLoc().
+  TypeDispatcher = TtNNTypeLocDispatcher::subscribe(
+      Finder, {TtNNTypeKind::OperationAttributes, TtNNTypeKind::TensorArgs},
+      this, isSpelledInSourceOnly());
 }
 
-// Get the suggested replacement name for the struct
-// operation_attributes_t -> {Operation}Params
-// tensor_args_t -> {Operation}Inputs
-std::string getSuggestedName(llvm::StringRef CurrentName,
-                             const std::string &OperationName) {
-  std::string PascalOp = toPascalCase(OperationName);
-
-  if (CurrentName == kOperationAttributesT) {
-    return PascalOp + "Params";
-  } else if (CurrentName == kTensorArgsT) {
-    return PascalOp + "Inputs";
+void TtNNOperationTypeNamingCheck::check(
+    const MatchFinder::MatchResult &Result) {
+  if (handleTraversalScope(Result)) {
+    return;
   }
 
-  return "";
-}
+  const clang::SourceManager &SM = *Result.SourceManager;
 
-// Extract operation name from a fully qualified type string
-// e.g., "ttnn::operations::data_movement::slice::operation_attributes_t" -> "slice"
-// e.g., "struct ttnn::operations::data_movement::slice::operation_attributes_t" -> "slice"
-std::string extractOperationFromFullyQualifiedType(const std::string &TypeStr) {
-  // Look for operation_attributes_t or tensor_args_t in the type string
-  std::string TargetType;
-  size_t TypePos = TypeStr.find(kOperationAttributesT);
-  if (TypePos != std::string::npos) {
-    TargetType = kOperationAttributesT;
-  } else {
-    TypePos = TypeStr.find(kTensorArgsT);
-    if (TypePos != std::string::npos) {
-      TargetType = kTensorArgsT;
+  if (!IndexDirectory.empty()) {
+    if (Result.Nodes.getNodeAs<TranslationUnitDecl>("index_translation_unit")) {
+      MainFile = getRealPath(SM.getMainFileID(), SM);
+    } else if (const auto *Record = Result.Nodes.getNodeAs<CXXRecordDecl>(
+                   "index_struct_decl")) {
+      indexDefinition(*Record, SM);
+    } else if (const auto *TL =
+                   Result.Nodes.getNodeAs<TypeLoc>("index_type_loc")) {
+      indexUsage(*TL, *Result.Nodes.getNodeAs<CXXRecordDecl>("index_type_decl"),
+                 SM);
     }
+    return;
   }
 
-  if (TargetType.empty() || TypePos == 0) {
-    return "";
-  }
-
-  // Look for "::" before the type name to find the namespace
-  if (TypePos < 2 || TypeStr.substr(TypePos - 2, 2) != "::") {
-    return "";
+  // Handle struct definitions (rename in types files)
+  const auto *StructDecl =
+      Result.Nodes.getNodeAs<clang::CXXRecordDecl>("struct_decl");
+  if (!StructDecl) {
+    return;
   }
-
-  // Find the namespace before ::operation_attributes_t or ::tensor_args_t
-  size_t NamespaceEnd = TypePos - 2;
-  size_t NamespaceStart = NamespaceEnd;
-
-  // Walk backwards to find the start of the namespace
-  while (NamespaceStart > 0) {
-    char C = TypeStr[NamespaceStart - 1];
-    if (C == ':' || C == ' ') {
-      break;
-    }
-    NamespaceStart--;
+  countStage("struct_decl.callback");
+  if (isReplayedFromCache(StructDecl->getLocation(), SM)) {
+    countStage("struct_decl.replayed_from_cache");
+    return;
   }
 
-  if (NamespaceStart >= NamespaceEnd) {
-    return "";
+  TtNNSemanticModel &Model = getModel();
+  if (!Model.isInTypesFile(StructDecl->getLocation())) {
+    countStage("struct_decl.not_types_file");
+    return;
   }
 
-  return TypeStr.substr(NamespaceStart, NamespaceEnd - NamespaceStart);
-}
+  llvm::StringRef StructName = StructDecl->getName();
+  StringRef OperationName =
+      Model.getOperationName(StructDecl->getDeclContext());
 
-// Check if a type represents one of our target types
-bool isTargetType(const std::string &TypeStr) {
-  // Skip DeviceOperation:: member types - these are the aliases themselves
-  if (TypeStr.find("DeviceOperation::") != std::string::npos) {
-    return false;
+  if (OperationName.empty()) {
+    countStage("struct_decl.no_operation_name");
+    report(StructDecl->getLocation(),
+           "generic type name '%0' should be renamed to an operation-specific "
+           "name (e.g., '{Operation}Params' or '{Operation}Inputs')",
+           {StructName}, ArrayRef<FixItHint>(), SM);
+    return;
   }
 
-  // Look for fully qualified names containing our target types
-  return TypeStr.find("::" + std::string(kOperationAttributesT)) != std::string::npos ||
-         TypeStr.find("::" + std::string(kTensorArgsT)) != std::string::npos;
-}
-
-// Get the target type name from a type string
-std::string getTargetTypeName(const std::string &TypeStr) {
-  if (TypeStr.find(kOperationAttributesT) != std::string::npos) {
-    return kOperationAttributesT;
-  }
-  if (TypeStr.find(kTensorArgsT) != std::string::npos) {
-    return kTensorArgsT;
+  std::string SuggestedName = getSuggestedName(StructName, OperationName);
+  if (SuggestedName.empty()) {
+    countStage("struct_decl.no_suggested_name");
+    return;
   }
-  return "";
-}
 
-} // namespace
+  countStage("struct_decl.reported");
+  auto Timer = timePath("fix.rename_struct");
 
-void TtNNOperationTypeNamingCheck::registerMatchers(MatchFinder *Finder) {
-  // Case 1: Match struct/class definitions with the target names (for renaming in types files)
-  Finder->addMatcher(
-      cxxRecordDecl(isDefinition(),
-                    anyOf(hasName(kOperationAttributesT), hasName(kTensorArgsT)))
-          .bind("struct_decl"),
-      this);
+  // Get the location of just the struct name for the fix-it
+  clang::SourceLocation NameLoc = StructDecl->getLocation();
 
-  // Case 2: Match type usages (for updating references to the renamed types)
-  Finder->addMatcher(typeLoc().bind("type_loc"), this);
+  // Add fix-it to rename the struct
+  report(NameLoc, "generic type name '%0' should be renamed to '%1'",
+         {StructName, SuggestedName},
+         replaceToken(NameLoc, StructName, SuggestedName, SM, getLangOpts()),
+         SM);
 }
 
-void TtNNOperationTypeNamingCheck::check(
+void TtNNOperationTypeNamingCheck::checkTypeLoc(
+    const TypeLoc &TL, const NamedDecl &Decl, TtNNTypeKind Kind,
     const MatchFinder::MatchResult &Result) {
+  // Handle type usages (update references)
   const clang::SourceManager &SM = *Result.SourceManager;
+  const clang::LangOptions &LO = getLangOpts();
+  countStage("type_loc.callback");
 
-  // Handle struct definitions (rename in types files)
-  if (const auto *StructDecl =
-          Result.Nodes.getNodeAs<clang::CXXRecordDecl>("struct_decl")) {
-    if (!SM.isInMainFile(StructDecl->getLocation())) {
-      return;
-    }
-
-    llvm::StringRef Filename = SM.getFilename(StructDecl->getLocation());
-    if (!isTypesFile(Filename)) {
-      return;
-    }
-
-    llvm::StringRef StructName = StructDecl->getName();
-    const clang::DeclContext *DC = StructDecl->getDeclContext();
-    std::string OperationName = extractOperationName(DC);
-
-    if (OperationName.empty()) {
-      diag(StructDecl->getLocation(),
-           "generic type name '%0' should be renamed to an operation-specific "
-           "name (e.g., '{Operation}Params' or '{Operation}Inputs')")
-          << StructName;
-      return;
-    }
-
-    std::string SuggestedName = getSuggestedName(StructName, OperationName);
-    if (SuggestedName.empty()) {
-      return;
-    }
-
-    // Get the location of just the struct name for the fix-it
-    clang::SourceLocation NameLoc = StructDecl->getLocation();
-
-    auto Diag = diag(NameLoc, "generic type name '%0' should be renamed to '%1'")
-                << StructName << SuggestedName;
-
-    // Add fix-it to rename the struct
-    Diag << clang::FixItHint::CreateReplacement(
-        clang::CharSourceRange::getTokenRange(NameLoc, NameLoc), SuggestedName);
-
+  // Skip types files - we only want to fix usages, not the definitions themselves
+  TtNNSemanticModel &Model = getModel();
+  if (Model.isInTypesFile(TL.getBeginLoc())) {
+    countStage("type_loc.in_types_file");
     return;
   }
 
-  // Handle type usages (update references)
-  if (const auto *TL = Result.Nodes.getNodeAs<clang::TypeLoc>("type_loc")) {
-    if (!SM.isInMainFile(TL->getBeginLoc())) {
-      return;
-    }
-
-    // Skip types files - we only want to fix usages, not the definitions themselves
-    llvm::StringRef Filename = SM.getFilename(TL->getBeginLoc());
-    if (isTypesFile(Filename)) {
-      return;
-    }
+  // The dispatcher only hands us namespace-level structs, so the operation is
+  // resolved from the declaration rather than from a printed type.
+  StringRef OperationName = Model.getOperationName(Decl.getDeclContext());
+  if (OperationName.empty()) {
+    countStage("type_loc.no_operation_name");
+    return;
+  }
 
-    // Only handle specific TypeLoc kinds that represent actual type names in source
-    // This avoids matching implied types, function types, etc.
-    clang::TypeLoc InnerTL = *TL;
-
-    // Try to get RecordTypeLoc or TypedefTypeLoc directly
-    auto RecTL = InnerTL.getAs<clang::RecordTypeLoc>();
-    if (!RecTL) {
-      // Also check for elaborated types like "struct foo" or "class foo"
-      if (auto ElabTL = InnerTL.getAs<clang::ElaboratedTypeLoc>()) {
-        RecTL = ElabTL.getNamedTypeLoc().getAs<clang::RecordTypeLoc>();
-      }
-    }
+  std::string SuggestedName = getSuggestedName(Decl.getName(), OperationName);
+  if (SuggestedName.empty()) {
+    countStage("type_loc.no_suggested_name");
+    return;
+  }
 
-    if (!RecTL) {
-      return;
-    }
+  // The dispatched location covers the whole elaborated type, so a
+  // namespace qualifier (slice::operation_attributes_t) is replaced as well
+  clang::SourceRange Range = TL.getSourceRange();
+  if (Range.isInvalid()) {
+    countStage("type_loc.invalid_range");
+    return;
+  }
 
-    clang::QualType QT = RecTL.getType();
-    if (QT.isNull()) {
-      return;
-    }
+  countStage("type_loc.reported");
+  auto Timer = timePath("fix.replace_type_loc");
 
-    // Get the fully qualified type string to check if it's a target type
-    std::string FullTypeStr = QT.getCanonicalType().getAsString();
+  // Get what's actually written in the source
+  llvm::StringRef WrittenType = clang::Lexer::getSourceText(
+      clang::CharSourceRange::getTokenRange(Range), SM, LO);
+  if (WrittenType.empty()) {
+    WrittenType = Decl.getName();
+  }
 
-    if (!isTargetType(FullTypeStr)) {
-      return;
-    }
+  report(Range.getBegin(), "replace '%0' with '%1'",
+         {WrittenType, SuggestedName},
+         replaceTokens(Range, SuggestedName, SM, LO), SM);
+}
 
-    // Extract operation name from the fully qualified type
-    std::string OperationName = extractOperationFromFullyQualifiedType(FullTypeStr);
-    if (OperationName.empty()) {
-      return;
-    }
+void TtNNOperationTypeNamingCheck::indexDefinition(const CXXRecordDecl &Record,
+                                                   const SourceManager &SM) {
+  addIndexRecord(RenameIndexRecord::Definition, Record, Record.getLocation(),
+                 SM);
+}
 
-    std::string TargetTypeName = getTargetTypeName(FullTypeStr);
-    if (TargetTypeName.empty()) {
-      return;
-    }
+void TtNNOperationTypeNamingCheck::indexUsage(const TypeLoc &TL,
+                                              const CXXRecordDecl &Record,
+                                              const SourceManager &SM) {
+  // Only the name token is recorded so qualifiers are kept as written
+  auto Elaborated = TL.getAs<ElaboratedTypeLoc>();
+  if (!Elaborated) {
+    return;
+  }
+  addIndexRecord(RenameIndexRecord::Usage, Record,
+                 Elaborated.getNamedTypeLoc().getBeginLoc(), SM);
+}
 
-    std::string SuggestedName = getSuggestedName(TargetTypeName, OperationName);
-    if (SuggestedName.empty()) {
-      return;
-    }
+void TtNNOperationTypeNamingCheck::addIndexRecord(
+    RenameIndexRecord::RecordKind Kind, const CXXRecordDecl &Record,
+    SourceLocation NameLoc, const SourceManager &SM) {
+  // Names produced by macros cannot be rewritten in place
+  if (NameLoc.isInvalid() || NameLoc.isMacroID()) {
+    return;
+  }
+  // Template instantiations revisit the same spelling
+  if (!IndexedLocs.insert(NameLoc).second) {
+    return;
+  }
 
-    // Get the source range for just the type name
-    clang::SourceRange Range = RecTL.getSourceRange();
-    if (Range.isInvalid()) {
-      return;
-    }
+  const CXXRecordDecl *Canonical = Record.getCanonicalDecl();
+  auto [KeyIt, NewKey] = KeyIds.try_emplace(Canonical);
+  if (NewKey) {
+    KeyIt->second = {
+        Index.intern(Canonical->getQualifiedNameAsString()),
+        Index.intern(getModel().getOperationName(Canonical->getDeclContext()))};
+  }
 
-    // For elaborated types (slice::operation_attributes_t), we want to replace
-    // the whole thing including the namespace qualifier
-    if (auto ElabTL = TL->getAs<clang::ElaboratedTypeLoc>()) {
-      Range = ElabTL.getSourceRange();
-    }
+  auto [FID, Offset] = SM.getDecomposedLoc(NameLoc);
+  auto [FileIt, NewFile] = FileIds.try_emplace(FID);
+  if (NewFile) {
+    FileIt->second = Index.intern(getRealPath(FID, SM));
+  }
 
-    // Get what's actually written in the source
-    std::string WrittenTypeStr = QT.getAsString();
+  Index.add({Kind, KeyIt->second.first, KeyIt->second.second, FileIt->second,
+             Offset, static_cast<unsigned>(Record.getName().size())});
+}
 
-    auto Diag = diag(Range.getBegin(), "replace '%0' with '%1'")
-                << WrittenTypeStr << SuggestedName;
+void TtNNOperationTypeNamingCheck::onEndOfTranslationUnit() {
+  TtNNCheck::onEndOfTranslationUnit();
+  if (IndexDirectory.empty() || MainFile.empty()) {
+    return;
+  }
 
-    Diag << clang::FixItHint::CreateReplacement(Range, SuggestedName);
+  // A shard is written even when empty so a stale one for the same file is
+  // replaced
+  if (llvm::Error Err = Index.writeShard(IndexDirectory, MainFile)) {
+    configurationDiag("cannot write rename index shard: %0")
+        << llvm::toString(std::move(Err));
   }
+
+  Index = RenameIndex();
+  MainFile.clear();
+  KeyIds.clear();
+  FileIds.clear();
+  IndexedLocs.clear();
 }
 
 } // namespace clang::tidy::ttnn
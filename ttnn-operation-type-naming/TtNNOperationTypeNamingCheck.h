@@ -7,6 +7,14 @@
 
 #include "clang-tidy/ClangTidy.h"
 #include "clang-tidy/ClangTidyCheck.h"
+#include "common/TtNNCheck.h"
+#include "common/TtNNRenameIndex.h"
+#include "common/TtNNTypeDispatcher.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+
+#include <memory>
+#include <string>
 
 namespace clang::tidy::ttnn {
 
@@ -16,14 +24,44 @@ namespace clang::tidy::ttnn {
 ///   - Flags `struct operation_attributes_t { ... };` -> suggests `{Operation}Params`
 ///   - Flags `struct tensor_args_t { ... };` -> suggests `{Operation}Inputs`
 ///
-/// The operation name is derived from the namespace (e.g., `slice` -> `Slice`).
+/// The operation name is derived from the namespace (e.g., `slice` -> `Slice`):
+/// the innermost one that is not listed in the `CategoryNamespaces` option,
+/// as resolved by the shared semantic model.
+///
+/// With the `IndexDirectory` option set the check reports nothing. Instead it
+/// records every definition and usage of the two structs in the translation
+/// unit, headers included, and writes them as one index shard into that
+/// directory. `ttnn-rename-apply` merges the shards into a single set of
+/// replacements for the whole project.
 ///
-class TtNNOperationTypeNamingCheck : public ClangTidyCheck {
+class TtNNOperationTypeNamingCheck : public TtNNCheck,
+                                     public TtNNTypeLocHandler {
 public:
-  TtNNOperationTypeNamingCheck(StringRef Name, ClangTidyContext *Context)
-      : ClangTidyCheck(Name, Context) {}
+  TtNNOperationTypeNamingCheck(StringRef Name, ClangTidyContext *Context);
+  void storeOptions(ClangTidyOptions::OptionMap &Opts) override;
   void registerMatchers(ast_matchers::MatchFinder *Finder) override;
   void check(const ast_matchers::MatchFinder::MatchResult &Result) override;
+  void checkTypeLoc(const TypeLoc &TL, const NamedDecl &Decl, TtNNTypeKind Kind,
+                    const ast_matchers::MatchFinder::MatchResult &Result) override;
+  void onEndOfTranslationUnit() override;
+
+private:
+  void indexDefinition(const CXXRecordDecl &Record, const SourceManager &SM);
+  void indexUsage(const TypeLoc &TL, const CXXRecordDecl &Record,
+                  const SourceManager &SM);
+  void addIndexRecord(RenameIndexRecord::RecordKind Kind,
+                      const CXXRecordDecl &Record, SourceLocation NameLoc,
+                      const SourceManager &SM);
+
+  const std::string IndexDirectory;
+  std::shared_ptr<TtNNTypeLocDispatcher> TypeDispatcher;
+
+  // Index mode state, for the current translation unit
+  RenameIndex Index;
+  std::string MainFile;
+  llvm::DenseMap<const CXXRecordDecl *, std::pair<unsigned, unsigned>> KeyIds;
+  llvm::DenseMap<FileID, unsigned> FileIds;
+  llvm::DenseSet<SourceLocation> IndexedLocs;
 };
 
 } // namespace clang::tidy::ttnn
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNProgramFactoryRuntimeArgsCheck.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Basic/SourceManager.h"
+#include "common/TtNNNames.h"
+#include "common/TtNNSemanticModel.h"
+#include "llvm/ADT/STLExtras.h"
+
+#include <string>
+
+using namespace clang::ast_matchers;
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+// Returns the definition of the struct \p SharedVariables declares or names
+const CXXRecordDecl *
+getSharedVariablesRecord(const NamedDecl &SharedVariables) {
+  const CXXRecordDecl *Record = nullptr;
+  if (const auto *Alias = dyn_cast<TypedefNameDecl>(&SharedVariables)) {
+    Record = Alias->getUnderlyingType()->getAsCXXRecordDecl();
+  } else {
+    Record = dyn_cast<CXXRecordDecl>(&SharedVariables);
+  }
+  return Record ? Record->getDefinition() : nullptr;
+}
+
+// Returns true if \p Type names the KernelHandle alias, directly, through
+// other aliases, or as the element of an array or of a container such as
+// std::vector<KernelHandle>. The alias is found in the type sugar, since it
+// only names an integer type.
+bool holdsKernelHandle(QualType Type, const ASTContext &Context) {
+  while (!Type.isNull()) {
+    const clang::Type *Current = Type.getTypePtr();
+    if (const auto *Typedef = dyn_cast<TypedefType>(Current)) {
+      const TypedefNameDecl *Alias = Typedef->getDecl();
+      if (Alias->getIdentifier() && Alias->getName() == kKernelHandle) {
+        return true;
+      }
+    } else if (const auto *Array = dyn_cast<ArrayType>(Current)) {
+      return holdsKernelHandle(Array->getElementType(), Context);
+    } else if (const auto *Specialization =
+                   dyn_cast<TemplateSpecializationType>(Current)) {
+      // The arguments as written keep their sugar, unlike those of the
+      // specialization they name
+      for (const TemplateArgument &Argument :
+           Specialization->template_arguments()) {
+        if (Argument.getKind() == TemplateArgument::Type &&
+            holdsKernelHandle(Argument.getAsType(), Context)) {
+          return true;
+        }
+      }
+    }
+    QualType Next = Type.getSingleStepDesugaredType(Context);
+    if (Next == Type) {
+      break;
+    }
+    Type = Next;
+  }
+  return false;
+}
+
+} // namespace
+
+void TtNNProgramFactoryRuntimeArgsCheck::registerMatchers(
+    MatchFinder *Finder) {
+  registerSharedMatchers(Finder);
+
+  // The model indexes the program factories in one walk of the namespaces,
+  // headers included, so the check only needs to run once per translation
+  // unit. Factories are usually declared in *_program_factory.hpp headers,
+  // which the matchers do not walk under a restricted traversal scope.
+  Finder->addMatcher(translationUnitDecl().bind("factory_unit"), this);
+}
+
+void TtNNProgramFactoryRuntimeArgsCheck::check(
+    const MatchFinder::MatchResult &Result) {
+  if (handleTraversalScope(Result)) {
+    return;
+  }
+  if (!Result.Nodes.getNodeAs<TranslationUnitDecl>("factory_unit")) {
+    return;
+  }
+
+  const SourceManager &SM = *Result.SourceManager;
+  for (const TtNNProgramFactory *Factory : getModel().getProgramFactories()) {
+    countStage("factory.callback");
+    const CXXRecordDecl &Record = *Factory->Record;
+    if (!isInReportedFile(Record.getLocation(), SM)) {
+      countStage("factory.not_reported_file");
+      continue;
+    }
+    if (isReplayedFromCache(Record.getLocation(), SM)) {
+      countStage("factory.replayed_from_cache");
+      continue;
+    }
+
+    std::string FactoryName = Record.getNameAsString();
+    if (!Factory->OverrideRuntimeArguments) {
+      countStage("factory.no_override_runtime_arguments");
+      report(Record.getLocation(),
+             "program factory '%0' has no static override_runtime_arguments, "
+             "so a program cache hit with new buffers cannot update the "
+             "cached program's runtime arguments",
+             {FactoryName}, ArrayRef<FixItHint>(), SM);
+    }
+
+    if (!Factory->SharedVariables) {
+      countStage("factory.no_shared_variables");
+      report(Record.getLocation(),
+             "program factory '%0' declares no shared_variables_t, so the "
+             "cached program keeps no kernel handles to update runtime "
+             "arguments through",
+             {FactoryName}, ArrayRef<FixItHint>(), SM);
+      continue;
+    }
+
+    const CXXRecordDecl *SharedVariables =
+        getSharedVariablesRecord(*Factory->SharedVariables);
+    if (!SharedVariables) {
+      countStage("factory.opaque_shared_variables");
+      continue;
+    }
+    if (llvm::any_of(SharedVariables->fields(), [&](const FieldDecl *Field) {
+          return holdsKernelHandle(Field->getType(), *Result.Context);
+        })) {
+      countStage("factory.keeps_kernel_handles");
+      continue;
+    }
+    countStage("factory.no_kernel_handles");
+    report(Factory->SharedVariables->getLocation(),
+           "shared_variables_t of program factory '%0' keeps no kernel "
+           "handles; override_runtime_arguments needs the KernelHandle of "
+           "every kernel whose runtime arguments hold a buffer address",
+           {FactoryName}, ArrayRef<FixItHint>(), SM);
+  }
+}
+
+} // namespace clang::tidy::ttnn
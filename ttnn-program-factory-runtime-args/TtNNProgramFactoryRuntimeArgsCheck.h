@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_TTNN_PROGRAM_FACTORY_RUNTIME_ARGS_CHECK_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_TTNN_PROGRAM_FACTORY_RUNTIME_ARGS_CHECK_H_
+
+#include "clang-tidy/ClangTidy.h"
+#include "clang-tidy/ClangTidyCheck.h"
+#include "common/TtNNCheck.h"
+
+namespace clang::tidy::ttnn {
+
+/// Flags program factories whose cached programs cannot be reused with new
+/// buffers.
+///
+/// On a program cache hit the cached program is run again with the runtime
+/// arguments patched by the factory's `override_runtime_arguments`, which
+/// finds the kernels to patch through the handles kept in
+/// `shared_variables_t`. A factory without either cannot update the buffer
+/// addresses, so a hit with new buffers falls back to building the program.
+///
+/// Looks at the namespace-level program factories the shared semantic model
+/// finds in the operation namespaces. Those declared in headers are reported
+/// when `-header-filter` admits the header, and take part in the header
+/// cache. Reports, at the factory, a missing `override_runtime_arguments` or
+/// `shared_variables_t`, and at the `shared_variables_t`, one that keeps no
+/// kernel handle: no field whose type names the `KernelHandle` alias, alone,
+/// in an array or in a container.
+///
+class TtNNProgramFactoryRuntimeArgsCheck : public TtNNCheck {
+public:
+  TtNNProgramFactoryRuntimeArgsCheck(StringRef Name, ClangTidyContext *Context)
+      : TtNNCheck(Name, Context) {}
+  void registerMatchers(ast_matchers::MatchFinder *Finder) override;
+  void check(const ast_matchers::MatchFinder::MatchResult &Result) override;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_TTNN_PROGRAM_FACTORY_RUNTIME_ARGS_CHECK_H_
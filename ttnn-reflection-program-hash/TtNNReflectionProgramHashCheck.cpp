@@ -0,0 +1,393 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNReflectionProgramHashCheck.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Basic/SourceManager.h"
+#include "common/TtNNNames.h"
+#include "common/TtNNSemanticModel.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <string>
+
+using namespace clang::ast_matchers;
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+// Deeper types are counted as one step, which also ends recursion through
+// containers of the type being estimated
+constexpr unsigned kMaxDepth = 8;
+
+// Returns true if \p Record or one of its bases declares a member named
+// \p Name
+bool declaresMember(const CXXRecordDecl &Record, StringRef Name) {
+  const CXXRecordDecl *Definition = Record.getDefinition();
+  if (!Definition) {
+    return false;
+  }
+  for (const Decl *D : Definition->decls()) {
+    const auto *Member = dyn_cast<NamedDecl>(D);
+    if (Member && Member->getIdentifier() && Member->getName() == Name) {
+      return true;
+    }
+  }
+  for (const CXXBaseSpecifier &Base : Definition->bases()) {
+    const CXXRecordDecl *BaseRecord = Base.getType()->getAsCXXRecordDecl();
+    if (BaseRecord && declaresMember(*BaseRecord, Name)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the definition of the attributes struct hashed for
+// \p DeviceOperation: the one its operation_attributes_t member names, or the
+// one declared in its operation namespace
+const CXXRecordDecl *
+findOperationAttributes(const CXXRecordDecl &DeviceOperation,
+                        const TtNNOperation &Operation) {
+  for (const Decl *D : DeviceOperation.decls()) {
+    const auto *Member = dyn_cast<NamedDecl>(D);
+    if (!Member || !Member->getIdentifier() ||
+        Member->getName() != kOperationAttributesT) {
+      continue;
+    }
+    const CXXRecordDecl *Record = nullptr;
+    if (const auto *Alias = dyn_cast<TypedefNameDecl>(Member)) {
+      Record = Alias->getUnderlyingType()->getAsCXXRecordDecl();
+    } else {
+      Record = dyn_cast<CXXRecordDecl>(Member);
+    }
+    return Record ? Record->getDefinition() : nullptr;
+  }
+
+  if (!Operation.OperationAttributes) {
+    return nullptr;
+  }
+  return Operation.OperationAttributes->getDefinition();
+}
+
+// How the reflection hash treats a standard library type
+enum class StdKind {
+  Other,
+  String,
+  Container,
+  Map,
+  Array,
+  Optional,
+  Variant,
+  Aggregate,
+  Handle
+};
+
+StdKind classifyStdRecord(StringRef Name) {
+  return llvm::StringSwitch<StdKind>(Name)
+      .Cases("basic_string", "basic_string_view", StdKind::String)
+      .Cases("vector", "deque", "list", "forward_list", StdKind::Container)
+      .Cases("set", "multiset", "unordered_set", "unordered_multiset",
+             StdKind::Container)
+      .Cases("map", "multimap", "unordered_map", "unordered_multimap",
+             StdKind::Map)
+      .Case("array", StdKind::Array)
+      .Case("optional", StdKind::Optional)
+      .Case("variant", StdKind::Variant)
+      .Cases("pair", "tuple", StdKind::Aggregate)
+      .Cases("shared_ptr", "unique_ptr", "reference_wrapper", "function",
+             StdKind::Handle)
+      .Default(StdKind::Other);
+}
+
+} // namespace
+
+TtNNReflectionProgramHashCheck::TtNNReflectionProgramHashCheck(
+    StringRef Name, ClangTidyContext *Context)
+    : TtNNCheck(Name, Context, /*CachesHeaders=*/false),
+      AssumedContainerSize(Options.get("AssumedContainerSize", 8U)),
+      FieldCostThreshold(Options.get("FieldCostThreshold", 16U)) {}
+
+void TtNNReflectionProgramHashCheck::storeOptions(
+    ClangTidyOptions::OptionMap &Opts) {
+  TtNNCheck::storeOptions(Opts);
+  Options.store(Opts, "AssumedContainerSize", AssumedContainerSize);
+  Options.store(Opts, "FieldCostThreshold", FieldCostThreshold);
+}
+
+void TtNNReflectionProgramHashCheck::registerMatchers(MatchFinder *Finder) {
+  registerSharedMatchers(Finder);
+
+  // Device operations are declared in *_device_operation.hpp headers, which
+  // the matchers do not walk under a restricted traversal scope. The model's
+  // operation index lists them wherever they are, once per translation unit.
+  Finder->addMatcher(translationUnitDecl().bind("operation_unit"), this);
+}
+
+void TtNNReflectionProgramHashCheck::check(
+    const MatchFinder::MatchResult &Result) {
+  if (handleTraversalScope(Result)) {
+    return;
+  }
+  if (!Result.Nodes.getNodeAs<TranslationUnitDecl>("operation_unit")) {
+    return;
+  }
+
+  for (const TtNNOperation *Operation : getModel().getOperations()) {
+    for (const CXXRecordDecl *DeviceOperation : Operation->DeviceOperations) {
+      checkDeviceOperation(*DeviceOperation, *Operation, Result);
+    }
+  }
+}
+
+void TtNNReflectionProgramHashCheck::checkDeviceOperation(
+    const CXXRecordDecl &DeviceOperation, const TtNNOperation &Operation,
+    const MatchFinder::MatchResult &Result) {
+  const SourceManager &SM = *Result.SourceManager;
+  countStage("device_operation.callback");
+  if (!isInReportedFile(DeviceOperation.getLocation(), SM)) {
+    countStage("device_operation.not_reported_file");
+    return;
+  }
+  if (DeviceOperation.isTemplated()) {
+    countStage("device_operation.template");
+    return;
+  }
+  if (declaresMember(DeviceOperation, "compute_program_hash")) {
+    countStage("device_operation.custom_hash");
+    return;
+  }
+
+  const CXXRecordDecl *Attributes =
+      findOperationAttributes(DeviceOperation, Operation);
+  if (!Attributes || Attributes->isDependentType()) {
+    countStage("device_operation.no_attributes");
+    return;
+  }
+  if (declaresMember(*Attributes, "attribute_values")) {
+    countStage("device_operation.custom_attributes");
+    return;
+  }
+
+  // The field diagnostics are in the types header, which may be left out
+  bool ReportsFields = isInReportedFile(Attributes->getLocation(), SM);
+
+  // The struct's own fields; bases only count towards the total
+  struct ExpensiveField {
+    const FieldDecl *Field;
+    HashCost Cost;
+  };
+  llvm::SmallVector<ExpensiveField, 4> ExpensiveFields;
+  for (const FieldDecl *Field : Attributes->fields()) {
+    HashCost Cost = estimateHashCost(Field->getType(), *Result.Context);
+    if (Cost.SizeDependent || Cost.Steps >= FieldCostThreshold) {
+      ExpensiveFields.push_back({Field, Cost});
+    }
+  }
+  if (ExpensiveFields.empty()) {
+    countStage("device_operation.cheap_hash");
+    return;
+  }
+
+  countStage("device_operation.reported");
+  HashCost Total =
+      estimateRecordCost(*Attributes, *Result.Context, /*Depth=*/0);
+  std::string OperationName = DeviceOperation.getName().str();
+  std::string AttributesName = Attributes->getNameAsString();
+  std::string TotalSteps = std::to_string(Total.Steps);
+  report(DeviceOperation.getLocation(),
+         "'%0' has no compute_program_hash, so every dispatch hashes all of "
+         "'%1' by reflection: ~%2 hash steps",
+         {OperationName, AttributesName, TotalSteps}, ArrayRef<FixItHint>(),
+         SM);
+  if (!ReportsFields) {
+    return;
+  }
+
+  std::string Assumed = " (" + std::to_string(AssumedContainerSize) +
+                        " elements assumed per container)";
+  for (const ExpensiveField &Expensive : ExpensiveFields) {
+    std::string FieldName = Expensive.Field->getNameAsString();
+    std::string Steps = std::to_string(Expensive.Cost.Steps);
+    report(Expensive.Field->getLocation(),
+           "field '%0' adds ~%1 hash steps to every dispatch of '%2'%3",
+           {FieldName, Steps, OperationName,
+            Expensive.Cost.SizeDependent ? StringRef(Assumed) : StringRef()},
+           ArrayRef<FixItHint>(), SM);
+  }
+}
+
+void TtNNReflectionProgramHashCheck::onEndOfTranslationUnit() {
+  TtNNCheck::onEndOfTranslationUnit();
+  Costs.clear();
+  TruncatedCosts.clear();
+}
+
+TtNNReflectionProgramHashCheck::HashCost
+TtNNReflectionProgramHashCheck::estimateHashCost(QualType Type,
+                                                 ASTContext &Context,
+                                                 unsigned Depth) {
+  // A reference member hashes what it refers to
+  QualType Canonical =
+      Context.getCanonicalType(Type.getNonReferenceType()).getUnqualifiedType();
+  if (Canonical->isDependentType()) {
+    return HashCost();
+  }
+  const clang::Type *Key = Canonical.getTypePtr();
+  auto It = Costs.find(Key);
+  if (It != Costs.end()) {
+    return It->second;
+  }
+  if (Depth > kMaxDepth) {
+    HashCost Cost;
+    Cost.Truncated = true;
+    return Cost;
+  }
+  auto Truncated = TruncatedCosts.find({Key, Depth});
+  if (Truncated != TruncatedCosts.end()) {
+    return Truncated->second;
+  }
+
+  HashCost Cost;
+  if (const ConstantArrayType *Array =
+          Context.getAsConstantArrayType(Canonical)) {
+    HashCost Element =
+        estimateHashCost(Array->getElementType(), Context, Depth + 1);
+    Cost.Steps = llvm::SaturatingMultiply(
+        static_cast<unsigned>(Array->getSize().getLimitedValue(~0U)),
+        Element.Steps);
+    Cost.SizeDependent = Element.SizeDependent;
+    Cost.Truncated = Element.Truncated;
+  } else if (const CXXRecordDecl *Record = Canonical->getAsCXXRecordDecl()) {
+    Cost = estimateRecordCost(*Record, Context, Depth);
+  }
+  // Recursion may have grown the maps, so the iterators are not reused. A
+  // cost cut short at kMaxDepth only holds at the depth it was reached from.
+  if (Cost.Truncated) {
+    TruncatedCosts[{Key, Depth}] = Cost;
+  } else {
+    Costs[Key] = Cost;
+  }
+  return Cost;
+}
+
+TtNNReflectionProgramHashCheck::HashCost
+TtNNReflectionProgramHashCheck::estimateRecordCost(const CXXRecordDecl &Record,
+                                                   ASTContext &Context,
+                                                   unsigned Depth) {
+  auto Add = [](HashCost &Sum, HashCost Part) {
+    Sum.Steps = llvm::SaturatingAdd(Sum.Steps, Part.Steps);
+    Sum.SizeDependent |= Part.SizeDependent;
+    Sum.Truncated |= Part.Truncated;
+  };
+
+  const auto *Specialization =
+      dyn_cast<ClassTemplateSpecializationDecl>(&Record);
+  StringRef Name = Record.getIdentifier() ? Record.getName() : StringRef();
+  bool IsSmallVector = Name == "SmallVector";
+  if (Specialization && (Record.isInStdNamespace() || IsSmallVector)) {
+    StdKind Kind = IsSmallVector ? StdKind::Container : classifyStdRecord(Name);
+    llvm::SmallVector<QualType, 4> Arguments;
+    for (const TemplateArgument &Argument :
+         Specialization->getTemplateArgs().asArray()) {
+      if (Argument.getKind() == TemplateArgument::Type) {
+        Arguments.push_back(Argument.getAsType());
+      } else if (Argument.getKind() == TemplateArgument::Pack) {
+        for (const TemplateArgument &Element : Argument.pack_elements()) {
+          if (Element.getKind() == TemplateArgument::Type) {
+            Arguments.push_back(Element.getAsType());
+          }
+        }
+      }
+    }
+    auto ArgumentCost = [&](size_t Index) {
+      return Index < Arguments.size()
+                 ? estimateHashCost(Arguments[Index], Context, Depth + 1)
+                 : HashCost();
+    };
+
+    HashCost Cost;
+    switch (Kind) {
+    case StdKind::String:
+      Cost.Steps = llvm::SaturatingAdd(1U, AssumedContainerSize);
+      Cost.SizeDependent = true;
+      return Cost;
+    case StdKind::Container:
+    case StdKind::Map: {
+      // The size, then every element; a map element is its key and value
+      HashCost Element = ArgumentCost(0);
+      if (Kind == StdKind::Map) {
+        Add(Element, ArgumentCost(1));
+      }
+      Cost.Steps = llvm::SaturatingAdd(
+          1U, llvm::SaturatingMultiply(AssumedContainerSize, Element.Steps));
+      Cost.SizeDependent = true;
+      Cost.Truncated = Element.Truncated;
+      return Cost;
+    }
+    case StdKind::Array: {
+      const TemplateArgumentList &Args = Specialization->getTemplateArgs();
+      if (Args.size() < 2 || Args[1].getKind() != TemplateArgument::Integral) {
+        return Cost;
+      }
+      HashCost Element = ArgumentCost(0);
+      Cost.Steps = llvm::SaturatingMultiply(
+          static_cast<unsigned>(
+              Args[1].getAsIntegral().getLimitedValue(~0U)),
+          Element.Steps);
+      Cost.SizeDependent = Element.SizeDependent;
+      Cost.Truncated = Element.Truncated;
+      return Cost;
+    }
+    case StdKind::Optional:
+      // Whether it is engaged, then the value
+      Add(Cost, ArgumentCost(0));
+      return Cost;
+    case StdKind::Variant:
+      // The index, then the held alternative, taken to be the costliest
+      for (size_t I = 0, E = Arguments.size(); I != E; ++I) {
+        HashCost Alternative = ArgumentCost(I);
+        Cost.Steps =
+            std::max(Cost.Steps, llvm::SaturatingAdd(1U, Alternative.Steps));
+        Cost.SizeDependent |= Alternative.SizeDependent;
+        Cost.Truncated |= Alternative.Truncated;
+      }
+      return Cost;
+    case StdKind::Aggregate:
+      Cost.Steps = 0;
+      for (size_t I = 0, E = Arguments.size(); I != E; ++I) {
+        Add(Cost, ArgumentCost(I));
+      }
+      Cost.Steps = std::max(Cost.Steps, 1U);
+      return Cost;
+    case StdKind::Handle:
+    case StdKind::Other:
+      return Cost;
+    }
+  }
+
+  // Anything else is walked field by field, as reflection does
+  const CXXRecordDecl *Definition = Record.getDefinition();
+  if (!Definition || Definition->isDependentType()) {
+    return HashCost();
+  }
+  HashCost Cost;
+  Cost.Steps = 0;
+  for (const CXXBaseSpecifier &Base : Definition->bases()) {
+    Add(Cost, estimateHashCost(Base.getType(), Context, Depth + 1));
+  }
+  for (const FieldDecl *Field : Definition->fields()) {
+    Add(Cost, estimateHashCost(Field->getType(), Context, Depth + 1));
+  }
+  Cost.Steps = std::max(Cost.Steps, 1U);
+  return Cost;
+}
+
+} // namespace clang::tidy::ttnn
@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_TTNN_REFLECTION_PROGRAM_HASH_CHECK_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_TTNN_REFLECTION_PROGRAM_HASH_CHECK_H_
+
+#include "clang-tidy/ClangTidy.h"
+#include "clang-tidy/ClangTidyCheck.h"
+#include "common/TtNNCheck.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include <utility>
+
+namespace clang::tidy::ttnn {
+
+/// Flags device operations whose program cache key is an expensive
+/// reflection hash.
+///
+/// The program cache is looked up on every dispatch. A `*DeviceOperation`
+/// struct without a `compute_program_hash` gets the generic hash, which walks
+/// every field of its `operation_attributes_t` by reflection, whether or not
+/// the field affects the program. Vectors and strings are hashed element by
+/// element, and structs such as `MemoryConfig` field by field.
+///
+/// The attributes struct is the one the device operation's
+/// `operation_attributes_t` member names, or else the one declared in its
+/// operation namespace. The cost of each field is estimated in hash steps, one
+/// per scalar, with `AssumedContainerSize` elements in every container. When
+/// a field holds a container or costs at least `FieldCostThreshold` steps,
+/// the device operation gets a diagnostic with the total cost and each such
+/// field one with its own.
+///
+/// Attributes structs declaring `attribute_values`, which choose what the
+/// reflection hash sees, are not estimated.
+///
+/// The device operations are the namespace-level ones in the shared semantic
+/// model's operation index. Those declared in headers, usually
+/// `*_device_operation.hpp`, are reported when `-header-filter` admits the
+/// header. The diagnostics depend on the attributes struct and the field
+/// types, which are usually in other headers, so the check does not use the
+/// header cache.
+///
+class TtNNReflectionProgramHashCheck : public TtNNCheck {
+public:
+  TtNNReflectionProgramHashCheck(StringRef Name, ClangTidyContext *Context);
+  void storeOptions(ClangTidyOptions::OptionMap &Opts) override;
+  void registerMatchers(ast_matchers::MatchFinder *Finder) override;
+  void check(const ast_matchers::MatchFinder::MatchResult &Result) override;
+  void onEndOfTranslationUnit() override;
+
+private:
+  /// Estimated hash steps of a value, whether it depends on the assumed
+  /// container size, and whether it stopped counting at the depth limit.
+  struct HashCost {
+    unsigned Steps = 1;
+    bool SizeDependent = false;
+    bool Truncated = false;
+  };
+
+  void checkDeviceOperation(
+      const CXXRecordDecl &DeviceOperation, const TtNNOperation &Operation,
+      const ast_matchers::MatchFinder::MatchResult &Result);
+
+  HashCost estimateHashCost(QualType Type, ASTContext &Context,
+                            unsigned Depth = 0);
+  HashCost estimateRecordCost(const CXXRecordDecl &Record, ASTContext &Context,
+                              unsigned Depth);
+
+  const unsigned AssumedContainerSize;
+  const unsigned FieldCostThreshold;
+
+  // Estimates for the current translation unit, by canonical type, and the
+  // ones cut short at the depth limit by canonical type and depth
+  llvm::DenseMap<const Type *, HashCost> Costs;
+  llvm::DenseMap<std::pair<const Type *, unsigned>, HashCost> TruncatedCosts;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_TTNN_REFLECTION_PROGRAM_HASH_CHECK_H_
@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Apply phase of the project-wide operation type rename.
+//
+// Reads every index shard written by `ttnn-operation-type-naming` with the
+// `IndexDirectory` option, resolves one new name per struct and writes a
+// single deduplicated replacements file that clang-apply-replacements can
+// apply:
+//
+//   ttnn-rename-apply /tmp/ttnn-index -o /tmp/fixes/rename.yaml
+//   clang-apply-replacements /tmp/fixes
+
+#include "common/TtNNNames.h"
+#include "common/TtNNRenameIndex.h"
+#include "clang/Tooling/ReplacementsYaml.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/YAMLTraits.h"
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace clang::tidy::ttnn;
+
+namespace {
+
+llvm::cl::OptionCategory RenameApplyCategory("ttnn-rename-apply options");
+
+llvm::cl::list<std::string> IndexDirectories(
+    llvm::cl::Positional, llvm::cl::OneOrMore,
+    llvm::cl::desc("<index directory>..."), llvm::cl::cat(RenameApplyCategory));
+
+llvm::cl::opt<std::string>
+    OutputFile("o", llvm::cl::desc("Replacements file to write"),
+               llvm::cl::value_desc("file"), llvm::cl::init("-"),
+               llvm::cl::cat(RenameApplyCategory));
+
+/// What is known about one struct across all shards.
+struct KeyInfo {
+  unsigned Operation = 0;
+  bool Conflicting = false;
+  bool HasDefinition = false;
+  std::string NewName;
+};
+
+/// One rename site, identified by string table ids.
+struct Edit {
+  unsigned File;
+  unsigned Offset;
+  unsigned Length;
+  unsigned Key;
+
+  bool operator<(const Edit &Other) const {
+    return std::tie(File, Offset, Length, Key) <
+           std::tie(Other.File, Other.Offset, Other.Length, Other.Key);
+  }
+  bool operator==(const Edit &Other) const {
+    return std::tie(File, Offset, Length, Key) ==
+           std::tie(Other.File, Other.Offset, Other.Length, Other.Key);
+  }
+};
+
+llvm::raw_ostream &warning() { return llvm::WithColor::warning(); }
+
+bool readIndex(RenameIndex &Index) {
+  std::vector<std::string> Shards;
+  for (const std::string &Directory : IndexDirectories) {
+    std::error_code EC;
+    for (llvm::sys::fs::directory_iterator It(Directory, EC), End;
+         It != End && !EC; It.increment(EC)) {
+      if (llvm::sys::path::extension(It->path()) == ".ttnnidx") {
+        Shards.push_back(It->path());
+      }
+    }
+    if (EC) {
+      llvm::WithColor::error() << Directory << ": " << EC.message() << '\n';
+      return false;
+    }
+  }
+
+  // Sorted so the output does not depend on directory order
+  llvm::sort(Shards);
+  for (const std::string &Shard : Shards) {
+    if (llvm::Error Err = Index.readShard(Shard)) {
+      llvm::WithColor::error() << llvm::toString(std::move(Err)) << '\n';
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Works out the new name of every struct, dropping the ones whose operation
+/// or new name is ambiguous.
+void resolveKeys(const RenameIndex &Index,
+                 llvm::DenseMap<unsigned, KeyInfo> &Keys) {
+  for (const RenameIndexRecord &R : Index.records()) {
+    auto [It, Inserted] = Keys.try_emplace(R.Key);
+    KeyInfo &Info = It->second;
+    if (Inserted) {
+      Info.Operation = R.Operation;
+    } else if (Info.Operation != R.Operation && !Info.Conflicting) {
+      warning() << "'" << Index.getString(R.Key) << "' belongs to both '"
+                << Index.getString(Info.Operation) << "' and '"
+                << Index.getString(R.Operation) << "'; not renamed\n";
+      Info.Conflicting = true;
+    }
+    Info.HasDefinition |= R.Kind == RenameIndexRecord::Definition;
+  }
+
+  llvm::StringMap<unsigned> NewQualifiedNames;
+  for (auto &[Key, Info] : Keys) {
+    if (Info.Conflicting) {
+      continue;
+    }
+    llvm::StringRef QualifiedName = Index.getString(Key);
+    if (!Info.HasDefinition) {
+      // Renaming usages without the definition would break the build
+      warning() << "definition of '" << QualifiedName
+                << "' is not in the index; not renamed\n";
+      Info.Conflicting = true;
+      continue;
+    }
+
+    auto [Parent, Name] = QualifiedName.rsplit("::");
+    if (Name.empty()) {
+      std::swap(Parent, Name);
+    }
+    llvm::StringRef Operation = Index.getString(Info.Operation);
+    Info.NewName = Operation.empty() ? "" : getSuggestedName(Name, Operation);
+    if (Info.NewName.empty()) {
+      warning() << "no operation name for '" << QualifiedName
+                << "'; not renamed\n";
+      Info.Conflicting = true;
+      continue;
+    }
+
+    auto [NameIt, NewName] = NewQualifiedNames.try_emplace(
+        (Parent + "::" + Info.NewName).str(), Key);
+    if (!NewName) {
+      warning() << "'" << QualifiedName << "' and '"
+                << Index.getString(NameIt->second) << "' would both become '"
+                << NameIt->getKey() << "'; not renamed\n";
+      Info.Conflicting = true;
+      Keys[NameIt->second].Conflicting = true;
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  llvm::InitLLVM X(argc, argv);
+  llvm::cl::HideUnrelatedOptions(RenameApplyCategory);
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv,
+      "Merges ttnn-operation-type-naming index shards into one set of "
+      "replacements\n");
+
+  RenameIndex Index;
+  if (!readIndex(Index)) {
+    return 1;
+  }
+
+  llvm::DenseMap<unsigned, KeyInfo> Keys;
+  resolveKeys(Index, Keys);
+
+  // Headers are indexed once per including TU; collapse the copies
+  std::vector<Edit> Edits;
+  Edits.reserve(Index.records().size());
+  for (const RenameIndexRecord &R : Index.records()) {
+    if (!Keys[R.Key].Conflicting) {
+      Edits.push_back({R.File, R.Offset, R.Length, R.Key});
+    }
+  }
+  llvm::sort(Edits);
+  Edits.erase(std::unique(Edits.begin(), Edits.end()), Edits.end());
+
+  clang::tooling::TranslationUnitReplacements Replacements;
+  const Edit *Previous = nullptr;
+  for (const Edit &E : Edits) {
+    if (Previous && Previous->File == E.File &&
+        E.Offset < Previous->Offset + Previous->Length) {
+      warning() << Index.getString(E.File) << ":" << E.Offset
+                << ": overlapping rename of '" << Index.getString(E.Key)
+                << "' dropped\n";
+      continue;
+    }
+    Replacements.Replacements.emplace_back(Index.getString(E.File), E.Offset,
+                                           E.Length, Keys[E.Key].NewName);
+    Previous = &E;
+  }
+
+  std::error_code EC;
+  llvm::ToolOutputFile Out(OutputFile, EC, llvm::sys::fs::OF_Text);
+  if (EC) {
+    llvm::WithColor::error() << OutputFile << ": " << EC.message() << '\n';
+    return 1;
+  }
+  llvm::yaml::Output YAML(Out.os());
+  YAML << Replacements;
+  Out.keep();
+
+  llvm::errs() << Replacements.Replacements.size() << " replacements for "
+               << Keys.size() << " types\n";
+  return 0;
+}
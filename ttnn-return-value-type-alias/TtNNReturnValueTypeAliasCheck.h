@@ -7,6 +7,10 @@
 
 #include "clang-tidy/ClangTidy.h"
 #include "clang-tidy/ClangTidyCheck.h"
+#include "common/TtNNCheck.h"
+#include "common/TtNNTypeDispatcher.h"
+
+#include <memory>
 
 namespace clang::tidy::ttnn {
 
@@ -20,12 +24,18 @@ namespace clang::tidy::ttnn {
 ///   - Replaces `namespace::spec_return_value_t` with `TensorSpec`
 ///   - Replaces `namespace::tensor_return_value_t` with `Tensor`
 ///
-class TtNNReturnValueTypeAliasCheck : public ClangTidyCheck {
+class TtNNReturnValueTypeAliasCheck : public TtNNCheck,
+                                      public TtNNTypeLocHandler {
 public:
   TtNNReturnValueTypeAliasCheck(StringRef Name, ClangTidyContext *Context)
-      : ClangTidyCheck(Name, Context) {}
+      : TtNNCheck(Name, Context) {}
   void registerMatchers(ast_matchers::MatchFinder *Finder) override;
   void check(const ast_matchers::MatchFinder::MatchResult &Result) override;
+  void checkTypeLoc(const TypeLoc &TL, const NamedDecl &Decl, TtNNTypeKind Kind,
+                    const ast_matchers::MatchFinder::MatchResult &Result) override;
+
+private:
+  std::shared_ptr<TtNNTypeLocDispatcher> TypeDispatcher;
 };
 
 } // namespace clang::tidy::ttnn
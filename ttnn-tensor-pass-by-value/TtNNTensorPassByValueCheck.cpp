@@ -0,0 +1,215 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TtNNTensorPassByValueCheck.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Analysis/Analyses/ExprMutationAnalyzer.h"
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Lex/Lexer.h"
+#include "common/TtNNNames.h"
+#include "common/TtNNSemanticModel.h"
+#include "common/TtNNSourceEdits.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <optional>
+#include <string>
+
+using namespace clang::ast_matchers;
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+// Record types that may hold tensors by value. Only a prefilter: holdsTensors()
+// decides.
+auto tensorLikeType() {
+  return qualType(hasUnqualifiedDesugaredType(recordType(hasDeclaration(
+      cxxRecordDecl(hasAnyName(kTensor, "optional", "vector"))))));
+}
+
+// Returns true if \p Type is a tensor, or a std::optional or std::vector of
+// tensors
+bool holdsTensors(QualType Type) {
+  const CXXRecordDecl *Record = Type->getAsCXXRecordDecl();
+  if (!Record) {
+    return false;
+  }
+  if (TtNNSemanticModel::isTensorRecord(*Record)) {
+    return true;
+  }
+
+  const auto *Specialization =
+      dyn_cast<ClassTemplateSpecializationDecl>(Record);
+  if (!Specialization || !Specialization->isInStdNamespace() ||
+      !Specialization->getIdentifier() ||
+      (Specialization->getName() != "optional" &&
+       Specialization->getName() != "vector")) {
+    return false;
+  }
+  const TemplateArgumentList &Args = Specialization->getTemplateArgs();
+  if (Args.size() == 0 || Args[0].getKind() != TemplateArgument::Type) {
+    return false;
+  }
+  const CXXRecordDecl *Element = Args[0].getAsType()->getAsCXXRecordDecl();
+  return Element && TtNNSemanticModel::isTensorRecord(*Element);
+}
+
+// Returns true if \p Param is moved from in \p Body, explicitly or by being
+// returned, which moves a by-value parameter implicitly
+bool isMovedFrom(const ParmVarDecl &Param, const Stmt &Body,
+                 ASTContext &Context) {
+  auto Ref = declRefExpr(to(equalsNode(&Param)));
+  auto Move = callExpr(
+      callee(functionDecl(hasAnyName("::std::move", "::std::forward"))),
+      argumentCountIs(1), hasArgument(0, ignoringParenImpCasts(Ref)));
+  auto ImplicitMove = returnStmt(hasReturnValue(ignoringImplicit(anyOf(
+      Ref, cxxConstructExpr(argumentCountIs(1),
+                            hasArgument(0, ignoringImplicit(Ref)))))));
+  return !match(stmt(hasDescendant(stmt(anyOf(Move, ImplicitMove)))), Body,
+                Context)
+              .empty();
+}
+
+// Returns true if \p Function is a member of a device operation or a program
+// factory, or is declared in a ttnn::operations namespace
+bool isOperationCode(const FunctionDecl &Function, TtNNSemanticModel &Model) {
+  if (const auto *Method = dyn_cast<CXXMethodDecl>(&Function)) {
+    const CXXRecordDecl &Parent = *Method->getParent();
+    if (TtNNSemanticModel::isDeviceOperation(Parent) ||
+        Model.getProgramFactory(Parent)) {
+      return true;
+    }
+  }
+  return Model.isInOperationsNamespace(Function.getDeclContext());
+}
+
+} // namespace
+
+void TtNNTensorPassByValueCheck::registerMatchers(MatchFinder *Finder) {
+  registerSharedMatchers(Finder);
+
+  // By-value parameters only: a reference type does not desugar to a record
+  Finder->addMatcher(
+      functionDecl(isExpansionInAnalyzedFile(getTraversalScope()),
+                   isDefinition(), unless(isImplicit()),
+                   unless(cxxConstructorDecl()),
+                   unless(cxxMethodDecl(ofClass(cxxRecordDecl(isLambda())))),
+                   hasAnyParameter(parmVarDecl(hasType(tensorLikeType()))))
+          .bind("function"),
+      this);
+}
+
+void TtNNTensorPassByValueCheck::check(const MatchFinder::MatchResult &Result) {
+  if (handleTraversalScope(Result)) {
+    return;
+  }
+
+  const auto *Function = Result.Nodes.getNodeAs<FunctionDecl>("function");
+  if (!Function) {
+    return;
+  }
+  const SourceManager &SM = *Result.SourceManager;
+  const LangOptions &LO = getLangOpts();
+  countStage("function.callback");
+  if (isReplayedFromCache(Function->getLocation(), SM)) {
+    countStage("function.replayed_from_cache");
+    return;
+  }
+
+  // Templates are seen in their instantiations' terms, and a virtual
+  // function's signature is shared with its overrides
+  const auto *Method = dyn_cast<CXXMethodDecl>(Function);
+  const Stmt *Body = Function->getBody();
+  if (!Body) {
+    countStage("function.no_body");
+    return;
+  }
+  if (Function->isTemplated() || Function->isTemplateInstantiation()) {
+    countStage("function.template");
+    return;
+  }
+  if (Method && Method->isVirtual()) {
+    countStage("function.virtual");
+    return;
+  }
+  if (!isOperationCode(*Function, getModel())) {
+    countStage("function.not_operation");
+    return;
+  }
+
+  std::optional<ExprMutationAnalyzer> Mutations;
+  for (const ParmVarDecl *Param : Function->parameters()) {
+    if (Param->getType()->isReferenceType() ||
+        !holdsTensors(Param->getType())) {
+      continue;
+    }
+    countStage("parameter.callback");
+    if (isMovedFrom(*Param, *Body, *Result.Context)) {
+      countStage("parameter.moved");
+      continue;
+    }
+    if (!Mutations) {
+      Mutations.emplace(*Body, *Result.Context);
+    }
+    if (Mutations->isMutated(Param)) {
+      countStage("parameter.mutated");
+      continue;
+    }
+    if (!getModel().isOnlyCalled(*Function)) {
+      countStage("parameter.function_referenced");
+      continue;
+    }
+
+    countStage("parameter.reported");
+    auto Timer = timePath("fix.const_reference");
+
+    // Every declaration changes, or none does, so the fix needs every file
+    // that declares the function to be one this run rewrites
+    llvm::SmallVector<FixItHint, 4> FixIts;
+    unsigned Index = Param->getFunctionScopeIndex();
+    for (const FunctionDecl *Redecl : Function->redecls()) {
+      if (!isInReportedFile(Redecl->getLocation(), SM)) {
+        countStage("parameter.declaration_not_rewritten");
+        FixIts.clear();
+        break;
+      }
+      if (Index >= Redecl->getNumParams() ||
+          !makeConstReference(*Redecl->getParamDecl(Index), SM, LO, FixIts)) {
+        FixIts.clear();
+        break;
+      }
+    }
+
+    // Report what is actually written in the source
+    llvm::StringRef WrittenType;
+    if (const TypeSourceInfo *TSI = Param->getTypeSourceInfo()) {
+      WrittenType = Lexer::getSourceText(
+          CharSourceRange::getTokenRange(TSI->getTypeLoc().getSourceRange()),
+          SM, LO);
+    }
+    std::string TypeName =
+        WrittenType.empty()
+            ? Param->getType().getUnqualifiedType().getAsString()
+            : WrittenType.str();
+    std::string Described =
+        Param->getName().empty()
+            ? std::string("unnamed parameter")
+            : "parameter '" + Param->getName().str() + "'";
+    // Operators have no identifier to ask getName() for
+    std::string FunctionName = Function->getNameAsString();
+
+    report(Param->getLocation(),
+           "%0 of '%1' is copied but never moved from or modified; pass it "
+           "as 'const %2&'",
+           {Described, FunctionName, TypeName}, FixIts, SM);
+  }
+}
+
+} // namespace clang::tidy::ttnn
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TENSOR_PASS_BY_VALUE_CHECK_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TENSOR_PASS_BY_VALUE_CHECK_H_
+
+#include "clang-tidy/ClangTidy.h"
+#include "clang-tidy/ClangTidyCheck.h"
+#include "common/TtNNCheck.h"
+
+namespace clang::tidy::ttnn {
+
+/// Flags tensors that are copied into a function only to be read.
+///
+/// A `Tensor` parameter taken by value copies the tensor handle, which bumps
+/// the reference counts of its storage; `std::optional<Tensor>` and
+/// `std::vector<Tensor>` do the same for every tensor they hold. On the
+/// dispatch path this is paid on every call of the operation.
+///
+/// Looks at function definitions in `ttnn::operations` namespaces and at the
+/// members of `*DeviceOperation` structs and program factories (`invoke`,
+/// `compute_output_specs`, `create_output_tensors`, `create`, ...). A by-value
+/// `ttnn::Tensor` (or `tt::tt_metal::Tensor`), optional or vector of one is
+/// flagged when the body never moves from it and never modifies it, and the
+/// function is only ever called in the translation unit. The fix makes the
+/// parameter `const&` in every declaration of the function, and is only
+/// offered when every declaration is in a file the run reports on: the main
+/// file, or a header admitted by the traversal scope or `-header-filter`.
+///
+class TtNNTensorPassByValueCheck : public TtNNCheck {
+public:
+  TtNNTensorPassByValueCheck(StringRef Name, ClangTidyContext *Context)
+      : TtNNCheck(Name, Context) {}
+  void registerMatchers(ast_matchers::MatchFinder *Finder) override;
+  void check(const ast_matchers::MatchFinder::MatchResult &Result) override;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TENSOR_PASS_BY_VALUE_CHECK_H_
@@ -0,0 +1,252 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "HeaderTUs.h"
+#include "Preamble.h"
+#include "TokenFilter.h"
+#include "common/TtNNNames.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+/// The include directives of every file read so far, shared by all workers.
+class IncludeGraph {
+public:
+  /// Returns the include directives of \p Path, or nullptr if it cannot be
+  /// read.
+  const std::vector<IncludeDirective> *getIncludes(llvm::StringRef Path) {
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      auto It = Files.find(Path);
+      if (It != Files.end()) {
+        return It->second ? &*It->second : nullptr;
+      }
+    }
+
+    std::optional<std::vector<IncludeDirective>> Includes;
+    if (llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+            llvm::MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                        /*RequiresNullTerminator=*/false)) {
+      Includes = getIncludeDirectives((*Buffer)->getBuffer());
+    }
+
+    // Concurrent reads of the same file agree, so the first one is kept
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto &Entry = *Files.try_emplace(Path, std::move(Includes)).first;
+    return Entry.second ? &*Entry.second : nullptr;
+  }
+
+private:
+  std::mutex Mutex;
+  // StringMap values do not move on rehash, so the vectors can be handed out
+  llvm::StringMap<std::optional<std::vector<IncludeDirective>>> Files;
+};
+
+/// A file reached from a translation unit, and the directive of the file
+/// that first included it.
+struct ReachedFile {
+  static constexpr size_t NoIncluder = ~size_t(0);
+
+  std::string Path;
+  size_t Includer = NoIncluder; // index into the files reached before
+  size_t Directive = 0;
+};
+
+/// Returns what the includers of \p Files[\p Index] include before it,
+/// outermost includer first. Quoted includes are resolved to absolute paths
+/// so they can be forced in from any directory; the others are kept as
+/// spelled.
+std::vector<std::string> getPrerequisites(llvm::ArrayRef<ReachedFile> Files,
+                                          size_t Index,
+                                          const IncludeSearchPath &Path,
+                                          IncludeGraph &Graph) {
+  std::vector<std::vector<std::string>> Levels;
+  for (size_t Current = Index;
+       Files[Current].Includer != ReachedFile::NoIncluder;
+       Current = Files[Current].Includer) {
+    const ReachedFile &Includer = Files[Files[Current].Includer];
+    // The includer was read when the file was reached
+    const std::vector<IncludeDirective> &Includes =
+        *Graph.getIncludes(Includer.Path);
+    std::vector<std::string> &Level = Levels.emplace_back();
+    for (const IncludeDirective &Include :
+         llvm::ArrayRef(Includes).take_front(Files[Current].Directive)) {
+      std::string Resolved =
+          Include.Angled
+              ? std::string()
+              : resolveQuotedInclude(Includer.Path, Include.Target, Path);
+      Level.push_back(Resolved.empty() ? Include.Target : Resolved);
+    }
+  }
+
+  std::vector<std::string> Prerequisites;
+  for (const std::vector<std::string> &Level : llvm::reverse(Levels)) {
+    llvm::append_range(Prerequisites, Level);
+  }
+  return Prerequisites;
+}
+
+/// Returns the types headers \p File reaches through quoted includes, with
+/// \p File as their source.
+std::vector<HeaderTU> findReachedTypesHeaders(llvm::StringRef File,
+                                              const IncludeSearchPath &Path,
+                                              IncludeGraph &Graph) {
+  std::vector<HeaderTU> Headers;
+  std::vector<ReachedFile> Files;
+  llvm::StringSet<> Visited;
+  // Directives are pushed in reverse, so files are reached in include order
+  // and nothing a header's includers include before it can reach the header
+  std::vector<ReachedFile> Worklist = {{File.str()}};
+  for (const std::string &Forced : llvm::reverse(Path.ForcedIncludes)) {
+    Worklist.push_back({Forced});
+  }
+  while (!Worklist.empty()) {
+    ReachedFile Current = std::move(Worklist.back());
+    Worklist.pop_back();
+    if (!Visited.insert(Current.Path).second) {
+      continue;
+    }
+    size_t Index = Files.size();
+    Files.push_back(std::move(Current));
+    const std::string &CurrentPath = Files[Index].Path;
+    if (isTypesFile(CurrentPath) && CurrentPath != File) {
+      Headers.push_back({CurrentPath, File.str(),
+                         getPrerequisites(Files, Index, Path, Graph)});
+    }
+    const std::vector<IncludeDirective> *Includes =
+        Graph.getIncludes(CurrentPath);
+    if (!Includes) {
+      continue;
+    }
+    for (size_t I = Includes->size(); I-- != 0;) {
+      const IncludeDirective &Include = (*Includes)[I];
+      if (Include.Angled) {
+        continue;
+      }
+      std::string Resolved =
+          resolveQuotedInclude(CurrentPath, Include.Target, Path);
+      if (!Resolved.empty()) {
+        Worklist.push_back({std::move(Resolved), Index, I});
+      }
+    }
+  }
+  return Headers;
+}
+
+} // namespace
+
+std::vector<HeaderTU> findHeaderTUs(llvm::ArrayRef<TUJob> Jobs,
+                                    const tooling::CompilationDatabase &Database,
+                                    unsigned Threads) {
+  IncludeGraph Graph;
+  std::vector<std::vector<HeaderTU>> Reached(Jobs.size());
+  std::atomic<size_t> Next{0};
+  std::vector<std::thread> Workers;
+  for (unsigned W = 0, E = std::max(Threads, 1u); W != E; ++W) {
+    Workers.emplace_back([&] {
+      for (size_t I = Next++; I < Jobs.size(); I = Next++) {
+        std::vector<tooling::CompileCommand> Commands =
+            Database.getCompileCommands(Jobs[I].File);
+        if (!Commands.empty()) {
+          Reached[I] = findReachedTypesHeaders(
+              Jobs[I].File, getIncludeSearchPath(Commands.front()), Graph);
+        }
+      }
+    });
+  }
+  for (std::thread &Worker : Workers) {
+    Worker.join();
+  }
+
+  // The first source by path is picked so the borrowed flags do not depend
+  // on the schedule
+  llvm::StringMap<HeaderTU> Headers;
+  for (std::vector<HeaderTU> &FromSource : Reached) {
+    for (HeaderTU &TU : FromSource) {
+      auto [It, Inserted] = Headers.try_emplace(TU.Header, TU);
+      if (!Inserted && TU.Source < It->second.Source) {
+        It->second = std::move(TU);
+      }
+    }
+  }
+
+  std::vector<HeaderTU> Result;
+  for (auto &Entry : Headers) {
+    Result.push_back(std::move(Entry.second));
+  }
+  llvm::sort(Result, [](const HeaderTU &A, const HeaderTU &B) {
+    return A.Header < B.Header;
+  });
+  return Result;
+}
+
+llvm::Error writeHeaderDatabase(llvm::ArrayRef<HeaderTU> Headers,
+                                const tooling::CompilationDatabase &Database,
+                                llvm::StringRef Directory) {
+  llvm::SmallString<256> Path(Directory);
+  llvm::sys::path::append(Path, "compile_commands.json");
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(Path, EC, llvm::sys::fs::OF_Text);
+  if (EC) {
+    return llvm::createFileError(Path, EC);
+  }
+
+  llvm::json::OStream J(OS, /*IndentSize=*/2);
+  J.array([&] {
+    for (const HeaderTU &TU : Headers) {
+      std::vector<tooling::CompileCommand> Commands =
+          Database.getCompileCommands(TU.Source);
+      if (Commands.empty()) {
+        continue;
+      }
+      const tooling::CompileCommand &Command = Commands.front();
+      J.object([&] {
+        J.attribute("directory", Command.Directory);
+        J.attribute("file", TU.Header);
+        J.attributeArray("arguments", [&] {
+          J.value(Command.CommandLine.front());
+          for (const std::string &Arg : getPreambleArguments(Command)) {
+            J.value(Arg);
+          }
+          // What the source declares before the header is parsed first
+          for (const std::string &Prerequisite : TU.Prerequisites) {
+            J.value("-include");
+            J.value(Prerequisite);
+          }
+          // A header that is the main file warns about its own #pragma once
+          J.value("-Wno-pragma-once-outside-header");
+          J.value("-x");
+          J.value("c++");
+          J.value(TU.Header);
+        });
+      });
+    }
+  });
+  OS << '\n';
+
+  OS.close();
+  if (OS.has_error()) {
+    std::error_code WriteEC = OS.error();
+    OS.clear_error();
+    return llvm::createFileError(Path, WriteEC);
+  }
+  return llvm::Error::success();
+}
+
+} // namespace clang::tidy::ttnn
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_HEADERTUS_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_HEADERTUS_H_
+
+#include "Scheduler.h"
+#include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+
+#include <string>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+/// A types header analyzed as the main file of its own translation unit.
+struct HeaderTU {
+  std::string Header;
+  /// Source file whose compile command the header borrows.
+  std::string Source;
+  /// What the source includes before the header, along its chain of
+  /// includers, as `-include` arguments.
+  std::vector<std::string> Prerequisites;
+};
+
+/// Returns every `*_device_operation_types.hpp` header that the translation
+/// units in \p Jobs reach through quoted includes, each paired with the first
+/// source file, by path, that reaches it. Includes are resolved as for the
+/// pre-filter, and each file is read once.
+std::vector<HeaderTU> findHeaderTUs(llvm::ArrayRef<TUJob> Jobs,
+                                    const tooling::CompilationDatabase &Database,
+                                    unsigned Threads);
+
+/// Writes a `compile_commands.json` into \p Directory with one entry per
+/// header: the compile command of its source file with the header as the
+/// input, parsed as C++ rather than as a header, and its prerequisites
+/// forced in before it.
+llvm::Error writeHeaderDatabase(llvm::ArrayRef<HeaderTU> Headers,
+                                const tooling::CompilationDatabase &Database,
+                                llvm::StringRef Directory);
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_HEADERTUS_H_
@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MemoryBudget.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+constexpr llvm::StringLiteral kHistoryHeader = "ttnn-tidy-peak-memory 1";
+
+} // namespace
+
+std::optional<uint64_t> parseMemorySize(llvm::StringRef Text) {
+  Text = Text.trim();
+  unsigned Shift = 0;
+  if (!Text.empty()) {
+    switch (llvm::toUpper(Text.back())) {
+    case 'K':
+      Shift = 10;
+      break;
+    case 'M':
+      Shift = 20;
+      break;
+    case 'G':
+      Shift = 30;
+      break;
+    case 'T':
+      Shift = 40;
+      break;
+    }
+  }
+  if (Shift) {
+    Text = Text.drop_back();
+  }
+
+  uint64_t Value;
+  if (Text.getAsInteger(10, Value) || Value > (UINT64_MAX >> Shift)) {
+    return std::nullopt;
+  }
+  return Value << Shift;
+}
+
+llvm::Error PeakMemoryHistory::load() {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+      llvm::MemoryBuffer::getFile(Path, /*IsText=*/true,
+                                  /*RequiresNullTerminator=*/false);
+  if (!Buffer) {
+    if (Buffer.getError() == std::errc::no_such_file_or_directory) {
+      return llvm::Error::success();
+    }
+    return llvm::createFileError(Path, Buffer.getError());
+  }
+
+  llvm::StringRef Rest = (*Buffer)->getBuffer();
+  llvm::StringRef Line;
+  std::tie(Line, Rest) = Rest.split('\n');
+  if (Line != kHistoryHeader) {
+    return llvm::createFileError(
+        Path, llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                      "not a peak memory history"));
+  }
+
+  std::lock_guard<std::mutex> Lock(Mutex);
+  while (!Rest.empty()) {
+    std::tie(Line, Rest) = Rest.split('\n');
+    auto [Field, File] = Line.split(' ');
+    uint64_t Peak;
+    // A damaged line only costs that TU its estimate
+    if (!Field.getAsInteger(10, Peak) && !File.empty()) {
+      Peaks[File] = Peak;
+    }
+  }
+  return llvm::Error::success();
+}
+
+llvm::Error PeakMemoryHistory::save() const {
+  llvm::SmallString<256> TempPath;
+  int FD;
+  if (std::error_code EC = llvm::sys::fs::createUniqueFile(
+          Path + "-%%%%%%%%.tmp", FD, TempPath)) {
+    return llvm::createFileError(Path, EC);
+  }
+
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    // Sorted so the file does not depend on hash table order
+    std::vector<llvm::StringRef> Files;
+    for (const auto &Entry : Peaks) {
+      Files.push_back(Entry.getKey());
+    }
+    llvm::sort(Files);
+
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << kHistoryHeader << '\n';
+    for (llvm::StringRef File : Files) {
+      OS << Peaks.lookup(File) << ' ' << File << '\n';
+    }
+    OS.close();
+    if (OS.has_error()) {
+      std::error_code EC = OS.error();
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return llvm::createFileError(TempPath, EC);
+    }
+  }
+
+  if (std::error_code EC = llvm::sys::fs::rename(TempPath, Path)) {
+    llvm::sys::fs::remove(TempPath);
+    return llvm::createFileError(Path, EC);
+  }
+  return llvm::Error::success();
+}
+
+std::optional<uint64_t>
+PeakMemoryHistory::lookup(llvm::StringRef File) const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto It = Peaks.find(File);
+  if (It == Peaks.end()) {
+    return std::nullopt;
+  }
+  return It->second;
+}
+
+uint64_t PeakMemoryHistory::getLargest() const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  uint64_t Largest = 0;
+  for (const auto &Entry : Peaks) {
+    Largest = std::max(Largest, Entry.second);
+  }
+  return Largest;
+}
+
+void PeakMemoryHistory::record(llvm::ArrayRef<TUJob> Batch, uint64_t Peak) {
+  if (Batch.empty() || !Peak) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> Lock(Mutex);
+  if (Batch.size() == 1) {
+    Peaks[Batch.front().File] = Peak;
+    return;
+  }
+
+  // The process frees each AST before parsing the next TU, so its peak is an
+  // upper bound for every TU of the batch. If it is above all of their
+  // records, one of them grew; the largest is the most likely one.
+  llvm::StringMapEntry<uint64_t> *Largest = nullptr;
+  for (const TUJob &Job : Batch) {
+    auto [It, Inserted] = Peaks.try_emplace(Job.File, Peak);
+    if (!Inserted) {
+      It->second = std::min(It->second, Peak);
+    }
+    if (!Largest || It->second > Largest->second) {
+      Largest = &*It;
+    }
+  }
+  Largest->second = Peak;
+}
+
+void MemoryBudget::acquire(uint64_t Bytes) {
+  std::unique_lock<std::mutex> Lock(Mutex);
+  auto Fits = [&] { return Used == 0 || Used + Bytes <= Limit; };
+  if (!Fits()) {
+    ++Waits;
+    Released.wait(Lock, Fits);
+  }
+  Used += Bytes;
+  PeakProjected = std::max(PeakProjected, Used);
+}
+
+void MemoryBudget::release(uint64_t Bytes) {
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Used -= Bytes;
+  }
+  Released.notify_all();
+}
+
+} // namespace clang::tidy::ttnn
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_MEMORYBUDGET_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_MEMORYBUDGET_H_
+
+#include "Scheduler.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace clang::tidy::ttnn {
+
+/// Parses a memory size such as `48G`, `512M` or a plain byte count. The
+/// suffixes `K`, `M`, `G` and `T` are powers of 1024.
+std::optional<uint64_t> parseMemorySize(llvm::StringRef Text);
+
+/// Peak resident memory of the clang-tidy processes that analyzed each
+/// translation unit in earlier runs.
+///
+/// The history is a text file of `<bytes> <path>` lines, loaded once at the
+/// start of a run and written back atomically at its end. Entries of
+/// translation units outside the run are kept.
+class PeakMemoryHistory {
+public:
+  explicit PeakMemoryHistory(std::string Path) : Path(std::move(Path)) {}
+
+  /// Loads the history. A missing file is an empty history.
+  llvm::Error load();
+
+  /// Writes the history back.
+  llvm::Error save() const;
+
+  /// Returns the recorded peak of \p File in bytes.
+  std::optional<uint64_t> lookup(llvm::StringRef File) const;
+
+  /// Returns the largest recorded peak, or 0 if nothing is recorded.
+  uint64_t getLargest() const;
+
+  /// Records that one process analyzing \p Batch, one TU after the other,
+  /// peaked at \p Peak bytes.
+  void record(llvm::ArrayRef<TUJob> Batch, uint64_t Peak);
+
+private:
+  std::string Path;
+  mutable std::mutex Mutex;
+  llvm::StringMap<uint64_t> Peaks;
+};
+
+/// Admits batches into the worker pool only while the sum of their estimated
+/// peak memory stays within a budget.
+class MemoryBudget {
+public:
+  explicit MemoryBudget(uint64_t Limit) : Limit(Limit) {}
+
+  /// Blocks until \p Bytes fit next to the batches already admitted. A batch
+  /// larger than the whole budget is admitted once nothing else runs, so it
+  /// runs alone rather than never.
+  void acquire(uint64_t Bytes);
+
+  /// Returns the memory of a finished batch to the budget.
+  void release(uint64_t Bytes);
+
+  uint64_t getLimit() const { return Limit; }
+  /// Largest projected use at any point of the run.
+  uint64_t getPeakProjected() const { return PeakProjected; }
+  /// Number of batches that had to wait for memory.
+  unsigned getWaits() const { return Waits; }
+
+private:
+  const uint64_t Limit;
+  std::mutex Mutex;
+  std::condition_variable Released;
+  uint64_t Used = 0;
+  uint64_t PeakProjected = 0;
+  unsigned Waits = 0;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_MEMORYBUDGET_H_
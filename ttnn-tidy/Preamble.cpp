@@ -0,0 +1,295 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Preamble.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Program.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+/// Translation units sharing compile flags and a leading include sequence.
+struct PreambleGroup {
+  std::string Directory;
+  std::vector<std::string> Args;
+  std::vector<std::string> Includes; // common prefix of all members
+  std::string MainDirectory;         // shared by all members
+  std::vector<size_t> Members;       // indices into the jobs
+  std::string PCH;
+  std::string Dependencies;
+  double Seconds = 0;
+  bool Built = false;
+};
+
+void buildPCH(PreambleGroup &Group, llvm::StringRef Clang,
+              llvm::StringRef Directory, llvm::ArrayRef<std::string> ExtraArgs,
+              std::mutex &OutputMutex) {
+  std::string Identity = Group.Directory + "\n" + Group.MainDirectory +
+                         "\n" + llvm::join(Group.Args, "\n") + "\n" +
+                         llvm::join(Group.Includes, "\n");
+  std::string Stem = llvm::utohexstr(llvm::xxHash64(Identity));
+
+  llvm::SmallString<256> Header(Directory);
+  llvm::sys::path::append(Header, Stem + ".hpp");
+  llvm::SmallString<256> PCH(Directory);
+  llvm::sys::path::append(PCH, Stem + ".pch");
+  llvm::SmallString<256> Dependencies(Directory);
+  llvm::sys::path::append(Dependencies, Stem + ".d");
+  llvm::SmallString<256> Log(Directory);
+  llvm::sys::path::append(Log, Stem + ".log");
+
+  {
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(Header, EC, llvm::sys::fs::OF_Text);
+    if (EC) {
+      return;
+    }
+    OS << "// Shared preamble of " << Group.Members.size()
+       << " translation units\n";
+    for (const std::string &Include : Group.Includes) {
+      OS << Include << '\n';
+    }
+  }
+
+  std::vector<std::string> Args = {Clang.str()};
+  Args.insert(Args.end(), Group.Args.begin(), Group.Args.end());
+  Args.insert(Args.end(), ExtraArgs.begin(), ExtraArgs.end());
+  // Quoted includes are looked up next to the main file first
+  Args.push_back("-iquote");
+  Args.push_back(Group.MainDirectory);
+  for (llvm::StringRef Arg : {"-working-directory", Group.Directory.c_str(),
+                              "-x", "c++-header"}) {
+    Args.push_back(Arg.str());
+  }
+  Args.push_back(std::string(Header));
+  Args.push_back("-o");
+  Args.push_back(std::string(PCH));
+  // The result cache needs to know every header the PCH holds
+  Args.push_back("-MD");
+  Args.push_back("-MF");
+  Args.push_back(std::string(Dependencies));
+
+  std::vector<llvm::StringRef> ArgRefs(Args.begin(), Args.end());
+  std::optional<llvm::StringRef> Redirects[] = {
+      std::nullopt, llvm::StringRef(Log), llvm::StringRef(Log)};
+  auto Start = std::chrono::steady_clock::now();
+  int ExitCode =
+      llvm::sys::ExecuteAndWait(Clang, ArgRefs, std::nullopt, Redirects);
+  Group.Seconds = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - Start)
+                      .count();
+
+  Group.Built = ExitCode == 0;
+  if (Group.Built) {
+    Group.PCH = std::string(PCH);
+    Group.Dependencies = std::string(Dependencies);
+    return;
+  }
+
+  std::lock_guard<std::mutex> Lock(OutputMutex);
+  llvm::WithColor::warning()
+      << "cannot build the shared preamble of " << Group.Members.size()
+      << " translation units; they are analyzed without it\n";
+  if (llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Output =
+          llvm::MemoryBuffer::getFile(Log)) {
+    llvm::errs() << (*Output)->getBuffer();
+  }
+}
+
+} // namespace
+
+std::vector<std::string> readIncludePrefix(llvm::StringRef Content) {
+  std::vector<std::string> Includes;
+  bool InBlockComment = false;
+  while (!Content.empty()) {
+    llvm::StringRef Line;
+    std::tie(Line, Content) = Content.split('\n');
+    Line = Line.trim();
+
+    if (InBlockComment) {
+      size_t End = Line.find("*/");
+      if (End == llvm::StringRef::npos) {
+        continue;
+      }
+      InBlockComment = false;
+      Line = Line.drop_front(End + 2).trim();
+    }
+    if (Line.starts_with("/*")) {
+      size_t End = Line.find("*/", 2);
+      if (End == llvm::StringRef::npos) {
+        InBlockComment = true;
+        continue;
+      }
+      Line = Line.drop_front(End + 2).trim();
+    }
+    if (Line.empty() || Line.starts_with("//")) {
+      continue;
+    }
+
+    if (!Line.consume_front("#")) {
+      break;
+    }
+    Line = Line.ltrim();
+    if (Line.consume_front("include") &&
+        (Line.starts_with(" ") || Line.starts_with("<") ||
+         Line.starts_with("\""))) {
+      Line = Line.split("//").first.trim();
+      Includes.push_back(("#include " + Line).str());
+      continue;
+    }
+    if (Line.consume_front("pragma") && Line.trim() == "once") {
+      continue;
+    }
+    break;
+  }
+  return Includes;
+}
+
+std::vector<std::string>
+getPreambleArguments(const tooling::CompileCommand &Command) {
+  llvm::SmallString<256> Input(Command.Filename);
+  llvm::sys::fs::make_absolute(Command.Directory, Input);
+
+  std::vector<std::string> Args;
+  const std::vector<std::string> &CommandLine = Command.CommandLine;
+  for (size_t I = 1, E = CommandLine.size(); I < E; ++I) {
+    llvm::StringRef Arg = CommandLine[I];
+    if (Arg == "-c" || Arg == "-MD" || Arg == "-MMD" || Arg == "--") {
+      continue;
+    }
+    if (Arg == "-o" || Arg == "-MF" || Arg == "-MT" || Arg == "-MQ") {
+      ++I;
+      continue;
+    }
+    if (Arg.starts_with("-o") || Arg.starts_with("-MF") ||
+        Arg.starts_with("-MT") || Arg.starts_with("-MQ")) {
+      continue;
+    }
+    llvm::SmallString<256> Absolute(Arg);
+    llvm::sys::fs::make_absolute(Command.Directory, Absolute);
+    if (Arg == Command.Filename || Absolute == Input) {
+      continue;
+    }
+    Args.push_back(Arg.str());
+  }
+  return Args;
+}
+
+void PreambleStats::print(llvm::raw_ostream &OS) const {
+  OS << "shared preambles: " << Hits << "/" << TUs
+     << " translation units used one of " << (Groups - Failed) << " PCHs ("
+     << llvm::format("%.1f", TUs ? 100.0 * Hits / TUs : 0.0) << "%); built in "
+     << llvm::format("%.1f", BuildSeconds) << "s";
+  if (Failed) {
+    OS << " (" << Failed << " failed to build)";
+  }
+  OS << '\n';
+}
+
+PreambleStats buildSharedPreambles(std::vector<TUJob> &Jobs,
+                                   const tooling::CompilationDatabase &Database,
+                                   llvm::StringRef Clang,
+                                   llvm::StringRef Directory,
+                                   llvm::ArrayRef<std::string> ExtraArgs,
+                                   unsigned MinTUs, unsigned Threads) {
+  PreambleStats Stats;
+  Stats.TUs = Jobs.size();
+
+  std::vector<PreambleGroup> Groups;
+  llvm::StringMap<size_t> GroupIndex;
+  for (size_t I = 0, E = Jobs.size(); I != E; ++I) {
+    std::vector<tooling::CompileCommand> Commands =
+        Database.getCompileCommands(Jobs[I].File);
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Content =
+        llvm::MemoryBuffer::getFile(Jobs[I].File);
+    if (Commands.empty() || !Content) {
+      continue;
+    }
+    std::vector<std::string> Includes =
+        readIncludePrefix((*Content)->getBuffer());
+    if (Includes.empty()) {
+      continue;
+    }
+
+    // Quoted includes resolve next to the main file first, so only TUs in
+    // the same directory are sure to read the same headers for the prefix
+    const tooling::CompileCommand &Command = Commands.front();
+    std::vector<std::string> Args = getPreambleArguments(Command);
+    llvm::StringRef MainDirectory = llvm::sys::path::parent_path(Jobs[I].File);
+    std::string Key = Command.Directory + "\n" + MainDirectory.str() + "\n" +
+                      llvm::join(Args, "\n") + "\n" + Includes.front();
+
+    auto [It, Inserted] = GroupIndex.try_emplace(Key, Groups.size());
+    if (Inserted) {
+      Groups.push_back({Command.Directory, std::move(Args), std::move(Includes),
+                        MainDirectory.str(), {}, "", "", 0, false});
+    } else {
+      // The shared preamble is the longest include prefix common to all
+      PreambleGroup &Group = Groups[It->second];
+      size_t Common = 0;
+      while (Common < Group.Includes.size() && Common < Includes.size() &&
+             Group.Includes[Common] == Includes[Common]) {
+        ++Common;
+      }
+      Group.Includes.resize(Common);
+    }
+    Groups[It->second].Members.push_back(I);
+  }
+
+  std::vector<PreambleGroup *> Buildable;
+  for (PreambleGroup &Group : Groups) {
+    if (Group.Members.size() >= std::max(MinTUs, 1u)) {
+      Buildable.push_back(&Group);
+    }
+  }
+  Stats.Groups = Buildable.size();
+
+  // PCHs are independent, so they are built in parallel before any TU runs
+  std::atomic<size_t> Next{0};
+  std::mutex OutputMutex;
+  std::vector<std::thread> Workers;
+  for (unsigned W = 0, E = std::max(Threads, 1u); W != E; ++W) {
+    Workers.emplace_back([&] {
+      for (size_t I = Next++; I < Buildable.size(); I = Next++) {
+        buildPCH(*Buildable[I], Clang, Directory, ExtraArgs, OutputMutex);
+      }
+    });
+  }
+  for (std::thread &Worker : Workers) {
+    Worker.join();
+  }
+
+  for (const PreambleGroup *Group : Buildable) {
+    Stats.BuildSeconds += Group->Seconds;
+    if (!Group->Built) {
+      ++Stats.Failed;
+      continue;
+    }
+    for (size_t Member : Group->Members) {
+      Jobs[Member].PCH = Group->PCH;
+      Jobs[Member].PCHDependencies = Group->Dependencies;
+    }
+    Stats.Hits += Group->Members.size();
+  }
+  return Stats;
+}
+
+} // namespace clang::tidy::ttnn
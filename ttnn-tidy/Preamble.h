@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_PREAMBLE_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_PREAMBLE_H_
+
+#include "Scheduler.h"
+#include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <string>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+/// Returns the `#include` directives at the top of \p Content, up to the first
+/// line that is neither an include, a comment, blank nor `#pragma once`.
+std::vector<std::string> readIncludePrefix(llvm::StringRef Content);
+
+/// Returns the compile arguments of \p Command that affect how headers are
+/// parsed: the command without its input file, output and dependency-file
+/// flags. Equal results mean a preamble can be shared.
+std::vector<std::string>
+getPreambleArguments(const tooling::CompileCommand &Command);
+
+struct PreambleStats {
+  unsigned Groups = 0;     // distinct (flags, directory, prefix) groups
+  unsigned Failed = 0;     // groups whose PCH did not build
+  unsigned TUs = 0;        // translation units considered
+  unsigned Hits = 0;       // translation units that use a PCH
+  double BuildSeconds = 0; // wall time spent building PCHs, summed
+
+  void print(llvm::raw_ostream &OS) const;
+};
+
+/// Groups \p Jobs by compile flags, main file directory and shared include
+/// prefix, builds one PCH for every group of at least \p MinTUs translation
+/// units with \p Clang into \p Directory, and points the jobs of each built
+/// group at it.
+PreambleStats buildSharedPreambles(std::vector<TUJob> &Jobs,
+                                   const tooling::CompilationDatabase &Database,
+                                   llvm::StringRef Clang,
+                                   llvm::StringRef Directory,
+                                   llvm::ArrayRef<std::string> ExtraArgs,
+                                   unsigned MinTUs, unsigned Threads);
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_PREAMBLE_H_
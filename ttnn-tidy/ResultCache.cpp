@@ -0,0 +1,371 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ResultCache.h"
+#include "clang/Tooling/DiagnosticsYaml.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/YAMLTraits.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+#include <tuple>
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+constexpr llvm::StringLiteral kEntryHeader = "ttnn-tidy-result 1";
+constexpr llvm::StringLiteral kDependenciesHeader = "ttnn-tidy-deps 1";
+
+std::string hashName(llvm::StringRef Text, llvm::StringRef Extension) {
+  return llvm::utohexstr(llvm::xxHash64(Text)) + Extension.str();
+}
+
+std::unique_ptr<llvm::MemoryBuffer> readFile(const llvm::Twine &Path) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+      llvm::MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                  /*RequiresNullTerminator=*/false);
+  return Buffer ? std::move(*Buffer) : nullptr;
+}
+
+/// A dependency line: the content hash, a space and the path.
+bool parseDependency(llvm::StringRef Line, uint64_t &Hash,
+                     llvm::StringRef &Path) {
+  llvm::StringRef HashField;
+  std::tie(HashField, Path) = Line.split(' ');
+  return !HashField.getAsInteger(16, Hash) && !Path.empty();
+}
+
+// Same layout as the header cache entries: header lines, some of them
+// followed by a payload of the byte length given as their last field.
+class EntryReader {
+public:
+  explicit EntryReader(llvm::StringRef Buffer) : Rest(Buffer) {}
+
+  bool readLine(llvm::StringRef &Line) {
+    size_t End = Rest.find('\n');
+    if (End == llvm::StringRef::npos) {
+      return false;
+    }
+    Line = Rest.take_front(End);
+    Rest = Rest.drop_front(End + 1);
+    return true;
+  }
+
+  bool readPayload(llvm::StringRef LengthField, llvm::StringRef &Out) {
+    size_t Length;
+    if (LengthField.getAsInteger(10, Length) || Rest.size() < Length + 1 ||
+        Rest[Length] != '\n') {
+      return false;
+    }
+    Out = Rest.take_front(Length);
+    Rest = Rest.drop_front(Length + 1);
+    return true;
+  }
+
+private:
+  llvm::StringRef Rest;
+};
+
+} // namespace
+
+std::vector<std::string> parseMakeDependencies(llvm::StringRef Content) {
+  std::vector<std::string> Paths;
+  // Skip the target: everything up to the first unescaped ": "
+  size_t Colon = Content.find(": ");
+  if (Colon == llvm::StringRef::npos) {
+    return Paths;
+  }
+  Content = Content.drop_front(Colon + 2);
+
+  std::string Current;
+  for (size_t I = 0, E = Content.size(); I != E; ++I) {
+    char C = Content[I];
+    if (C == '\\' && I + 1 != E) {
+      char Next = Content[I + 1];
+      if (Next == '\n' || Next == '\r') {
+        ++I; // line continuation
+        continue;
+      }
+      if (Next == ' ' || Next == '#' || Next == '\\') {
+        Current += Next;
+        ++I;
+        continue;
+      }
+    }
+    if (C == '$' && I + 1 != E && Content[I + 1] == '$') {
+      Current += '$';
+      ++I;
+      continue;
+    }
+    if (llvm::isSpace(C)) {
+      if (!Current.empty()) {
+        Paths.push_back(std::move(Current));
+        Current.clear();
+      }
+      continue;
+    }
+    Current += C;
+  }
+  if (!Current.empty()) {
+    Paths.push_back(std::move(Current));
+  }
+  return Paths;
+}
+
+ResultCache::ResultCache(std::string Directory, std::string Identity)
+    : Directory(std::move(Directory)), Identity(std::move(Identity)) {}
+
+ResultCache::~ResultCache() {
+  if (!DependencyDirectory.empty()) {
+    llvm::sys::fs::remove_directories(DependencyDirectory);
+  }
+}
+
+std::error_code ResultCache::initialize() {
+  if (std::error_code EC = llvm::sys::fs::create_directories(Directory)) {
+    return EC;
+  }
+  // Dependency lists only live for one run, so concurrent runs never read
+  // each other's
+  llvm::SmallString<256> Path;
+  if (std::error_code EC =
+          llvm::sys::fs::createUniqueDirectory("ttnn-tidy-deps", Path)) {
+    return EC;
+  }
+  DependencyDirectory = std::string(Path);
+  return {};
+}
+
+std::string ResultCache::getKey(llvm::StringRef File,
+                                const tooling::CompileCommand &Command) {
+  std::string Key;
+  llvm::raw_string_ostream OS(Key);
+  OS << Identity << "\ndirectory=" << Command.Directory << "\n";
+  for (const std::string &Arg : Command.CommandLine) {
+    OS << "arg=" << Arg << "\n";
+  }
+  OS << "file=" << File << "\n"
+     << getConfigFiles(llvm::sys::path::parent_path(File));
+  return Key;
+}
+
+std::optional<std::vector<tooling::Diagnostic>>
+ResultCache::lookup(llvm::StringRef Key) {
+  llvm::SmallString<256> EntryPath(Directory);
+  llvm::sys::path::append(EntryPath, hashName(Key, ".ttnnres"));
+  std::unique_ptr<llvm::MemoryBuffer> Buffer = readFile(EntryPath);
+  if (!Buffer) {
+    return std::nullopt;
+  }
+
+  // Anything unexpected, including a hash collision, is treated as a miss
+  EntryReader Reader(Buffer->getBuffer());
+  llvm::StringRef Line;
+  llvm::StringRef Payload;
+  if (!Reader.readLine(Line) || Line != kEntryHeader) {
+    return std::nullopt;
+  }
+  if (!Reader.readLine(Line) || !Line.consume_front("K ") ||
+      !Reader.readPayload(Line, Payload) || Payload != Key) {
+    return std::nullopt;
+  }
+
+  while (true) {
+    if (!Reader.readLine(Line)) {
+      return std::nullopt;
+    }
+    if (Line.consume_front("Y ")) {
+      break;
+    }
+    uint64_t Hash;
+    llvm::StringRef Path;
+    if (!Line.consume_front("F ") || !parseDependency(Line, Hash, Path)) {
+      return std::nullopt;
+    }
+    std::optional<uint64_t> Current = hashFile(Path);
+    if (!Current || *Current != Hash) {
+      return std::nullopt;
+    }
+  }
+
+  tooling::TranslationUnitDiagnostics TUD;
+  if (!Reader.readPayload(Line, Payload)) {
+    return std::nullopt;
+  }
+  llvm::yaml::Input YAML(Payload);
+  YAML >> TUD;
+  if (YAML.error()) {
+    return std::nullopt;
+  }
+  ++Hits;
+  return std::move(TUD.Diagnostics);
+}
+
+bool ResultCache::store(const TUJob &Job,
+                        llvm::ArrayRef<tooling::Diagnostic> Diagnostics) {
+  if (Job.CacheKey.empty()) {
+    return false;
+  }
+
+  llvm::SmallString<256> ListPath(DependencyDirectory);
+  llvm::sys::path::append(ListPath, hashName(Job.File, ".deps"));
+  std::unique_ptr<llvm::MemoryBuffer> List = readFile(ListPath);
+  if (!List) {
+    return false;
+  }
+
+  std::string Dependencies;
+  llvm::StringSet<> Files;
+  llvm::StringRef Rest = List->getBuffer();
+  llvm::StringRef Line;
+  std::tie(Line, Rest) = Rest.split('\n');
+  if (Line != kDependenciesHeader) {
+    return false;
+  }
+  while (!Rest.empty()) {
+    std::tie(Line, Rest) = Rest.split('\n');
+    uint64_t Hash;
+    llvm::StringRef Path;
+    if (!parseDependency(Line, Hash, Path)) {
+      return false;
+    }
+    if (Files.insert(Path).second) {
+      Dependencies += ("F " + Line + "\n").str();
+    }
+  }
+
+  // Headers in the shared preamble were never entered by the TU itself
+  if (!Job.PCHDependencies.empty()) {
+    std::unique_ptr<llvm::MemoryBuffer> Make = readFile(Job.PCHDependencies);
+    if (!Make) {
+      return false;
+    }
+    llvm::StringRef PCHDirectory = llvm::sys::path::parent_path(Job.PCH);
+    for (const std::string &Dependency :
+         parseMakeDependencies(Make->getBuffer())) {
+      // The synthesized preamble header only repeats the TU's own includes
+      if (llvm::sys::path::parent_path(Dependency) == PCHDirectory) {
+        continue;
+      }
+      std::string Path = getRealPath(Dependency);
+      std::optional<uint64_t> Hash = hashFile(Path);
+      if (!Hash) {
+        return false;
+      }
+      if (Files.insert(Path).second) {
+        Dependencies += "F " + llvm::utohexstr(*Hash) + " " + Path + "\n";
+      }
+    }
+  }
+
+  // The batch reported for all of its TUs; this one can only have reported
+  // in the files it read
+  tooling::TranslationUnitDiagnostics TUD;
+  TUD.MainSourceFile = Job.File;
+  for (const tooling::Diagnostic &D : Diagnostics) {
+    if (Files.contains(getRealPath(D.Message.FilePath))) {
+      TUD.Diagnostics.push_back(D);
+    }
+  }
+  std::string Results;
+  {
+    llvm::raw_string_ostream OS(Results);
+    llvm::yaml::Output YAML(OS);
+    YAML << TUD;
+  }
+
+  std::string EntryPath = (llvm::Twine(Directory) + "/" +
+                           hashName(Job.CacheKey, ".ttnnres"))
+                              .str();
+  llvm::SmallString<256> TempPath;
+  int FD;
+  if (llvm::sys::fs::createUniqueFile(EntryPath + "-%%%%%%%%.tmp", FD,
+                                      TempPath)) {
+    return false;
+  }
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << kEntryHeader << '\n';
+    OS << "K " << Job.CacheKey.size() << '\n' << Job.CacheKey << '\n';
+    OS << Dependencies;
+    OS << "Y " << Results.size() << '\n' << Results << '\n';
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return false;
+    }
+  }
+  if (llvm::sys::fs::rename(TempPath, EntryPath)) {
+    llvm::sys::fs::remove(TempPath);
+    return false;
+  }
+  ++Stored;
+  return true;
+}
+
+std::optional<uint64_t> ResultCache::hashFile(llvm::StringRef Path) {
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto It = FileHashes.find(Path);
+    if (It != FileHashes.end()) {
+      return It->second;
+    }
+  }
+  std::optional<uint64_t> Hash;
+  if (std::unique_ptr<llvm::MemoryBuffer> Buffer = readFile(Path)) {
+    Hash = llvm::xxHash64(Buffer->getBuffer());
+  }
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return FileHashes.try_emplace(Path, Hash).first->second;
+}
+
+std::string ResultCache::getRealPath(llvm::StringRef Path) {
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto It = RealPaths.find(Path);
+    if (It != RealPaths.end()) {
+      return It->second;
+    }
+  }
+  llvm::SmallString<256> Real;
+  if (llvm::sys::fs::real_path(Path, Real)) {
+    Real = Path;
+  }
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return RealPaths.try_emplace(Path, std::string(Real)).first->second;
+}
+
+std::string ResultCache::getConfigFiles(llvm::StringRef Dir) {
+  if (Dir.empty()) {
+    return "";
+  }
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto It = ConfigFiles.find(Dir);
+    if (It != ConfigFiles.end()) {
+      return It->second;
+    }
+  }
+  // The nearest .clang-tidy may inherit from enclosing ones, so all of them
+  // are part of the key
+  std::string Result = getConfigFiles(llvm::sys::path::parent_path(Dir));
+  llvm::SmallString<256> Path(Dir);
+  llvm::sys::path::append(Path, ".clang-tidy");
+  if (std::unique_ptr<llvm::MemoryBuffer> Buffer = readFile(Path)) {
+    Result += ("config=" + Path + "\n").str();
+    Result += llvm::utohexstr(llvm::xxHash64(Buffer->getBuffer())) + "\n";
+  }
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return ConfigFiles.try_emplace(Dir, std::move(Result)).first->second;
+}
+
+} // namespace clang::tidy::ttnn
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_RESULTCACHE_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_RESULTCACHE_H_
+
+#include "Scheduler.h"
+#include "clang/Tooling/CompilationDatabase.h"
+#include "clang/Tooling/Core/Diagnostic.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+/// Returns the paths listed in the make-style dependency file \p Content,
+/// without the target.
+std::vector<std::string> parseMakeDependencies(llvm::StringRef Content);
+
+/// Stores the diagnostics of each translation unit so that unchanged ones are
+/// replayed instead of analyzed again.
+///
+/// An entry is found by a key over the compile command, the main file path,
+/// the `.clang-tidy` files that apply to it and the run identity (clang-tidy
+/// and plugin binaries, checks and options). It then lists every file the
+/// translation unit read with the hash of the content that was parsed, as
+/// recorded by the plugin; the entry is only used if all of them still hash
+/// the same. Entries are written atomically, so concurrent runs may share a
+/// directory.
+class ResultCache {
+public:
+  ResultCache(std::string Directory, std::string Identity);
+  ~ResultCache();
+
+  /// Creates the cache directories.
+  std::error_code initialize();
+
+  /// Directory the plugin writes its dependency lists to.
+  llvm::StringRef getDependencyDirectory() const { return DependencyDirectory; }
+
+  /// Returns the key of \p File compiled with \p Command.
+  std::string getKey(llvm::StringRef File,
+                     const tooling::CompileCommand &Command);
+
+  /// Returns the stored diagnostics of \p Key if every file they depend on is
+  /// unchanged.
+  std::optional<std::vector<tooling::Diagnostic>> lookup(llvm::StringRef Key);
+
+  /// Stores the results of \p Job, analyzed as part of a batch that reported
+  /// \p Diagnostics. Returns false if the plugin did not record its
+  /// dependencies.
+  bool store(const TUJob &Job,
+             llvm::ArrayRef<tooling::Diagnostic> Diagnostics);
+
+  unsigned hits() const { return Hits; }
+  unsigned stored() const { return Stored; }
+
+private:
+  /// Hashes \p Path, once per run.
+  std::optional<uint64_t> hashFile(llvm::StringRef Path);
+  /// Returns the canonical path of \p Path, once per run.
+  std::string getRealPath(llvm::StringRef Path);
+  /// Returns the `.clang-tidy` files that apply in \p Directory, with their
+  /// contents.
+  std::string getConfigFiles(llvm::StringRef Directory);
+
+  std::string Directory;
+  std::string DependencyDirectory;
+  std::string Identity;
+
+  std::mutex Mutex;
+  llvm::StringMap<std::optional<uint64_t>> FileHashes;
+  llvm::StringMap<std::string> RealPaths;
+  llvm::StringMap<std::string> ConfigFiles;
+
+  std::atomic<unsigned> Hits{0};
+  std::atomic<unsigned> Stored{0};
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_RESULTCACHE_H_
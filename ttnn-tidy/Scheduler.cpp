@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Scheduler.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace clang::tidy::ttnn {
+
+TUScheduler::TUScheduler(std::vector<TUJob> Jobs, unsigned Workers) {
+  Workers = std::max(Workers, 1u);
+  for (unsigned I = 0; I != Workers; ++I) {
+    Queues.push_back(std::make_unique<Queue>());
+  }
+
+  // Ties are broken by name so the schedule is reproducible
+  std::sort(Jobs.begin(), Jobs.end(), [](const TUJob &A, const TUJob &B) {
+    return A.Cost != B.Cost ? A.Cost > B.Cost : A.File < B.File;
+  });
+  for (size_t I = 0, E = Jobs.size(); I != E; ++I) {
+    Queue &Q = *Queues[I % Workers];
+    Q.Cost += Jobs[I].Cost;
+    Q.Jobs.push_back(std::move(Jobs[I]));
+  }
+}
+
+std::vector<TUJob> TUScheduler::take(unsigned Worker, unsigned MaxJobs) {
+  MaxJobs = std::max(MaxJobs, 1u);
+  std::vector<TUJob> Batch;
+  {
+    Queue &Own = *Queues[Worker % Queues.size()];
+    std::lock_guard<std::mutex> Lock(Own.Mutex);
+    takeBatch(Own, MaxJobs, /*FromBack=*/false, Batch);
+  }
+
+  // Keep trying while other queues still have work; a victim may be drained
+  // between picking it and locking it
+  while (Batch.empty() && steal(Worker, MaxJobs, Batch)) {
+  }
+  return Batch;
+}
+
+bool TUScheduler::steal(unsigned Worker, unsigned MaxJobs,
+                        std::vector<TUJob> &Batch) {
+  // Pick the queue with the most remaining cost as the victim
+  Queue *Victim = nullptr;
+  uint64_t VictimCost = 0;
+  bool AnyLeft = false;
+  for (size_t I = 1, E = Queues.size(); I != E; ++I) {
+    Queue &Q = *Queues[(Worker + I) % E];
+    std::lock_guard<std::mutex> Lock(Q.Mutex);
+    if (Q.Jobs.empty()) {
+      continue;
+    }
+    AnyLeft = true;
+    if (!Victim || Q.Cost > VictimCost) {
+      Victim = &Q;
+      VictimCost = Q.Cost;
+    }
+  }
+  if (!Victim) {
+    return AnyLeft;
+  }
+
+  // Take the cheapest jobs from the back, at most half of what is left, so
+  // the victim keeps its longest jobs
+  std::lock_guard<std::mutex> Lock(Victim->Mutex);
+  takeBatch(*Victim,
+            std::min<size_t>(MaxJobs, (Victim->Jobs.size() + 1) / 2),
+            /*FromBack=*/true, Batch);
+  return true;
+}
+
+void TUScheduler::takeBatch(Queue &Q, size_t MaxJobs, bool FromBack,
+                            std::vector<TUJob> &Batch) {
+  if (Q.Jobs.empty() || MaxJobs == 0) {
+    return;
+  }
+
+  // The first job decides the preamble; the rest of the batch is the next
+  // jobs in queue order that share it
+  auto Take = [&](std::deque<TUJob>::iterator It) {
+    Q.Cost -= It->Cost;
+    Batch.push_back(std::move(*It));
+    return Q.Jobs.erase(It);
+  };
+  if (FromBack) {
+    Take(std::prev(Q.Jobs.end()));
+    const std::string PCH = Batch.front().PCH;
+    for (size_t I = Q.Jobs.size(); I != 0 && Batch.size() < MaxJobs; --I) {
+      if (Q.Jobs[I - 1].PCH == PCH) {
+        Take(Q.Jobs.begin() + (I - 1));
+      }
+    }
+  } else {
+    Take(Q.Jobs.begin());
+    const std::string PCH = Batch.front().PCH;
+    for (auto It = Q.Jobs.begin();
+         It != Q.Jobs.end() && Batch.size() < MaxJobs;) {
+      It = It->PCH == PCH ? Take(It) : std::next(It);
+    }
+  }
+}
+
+} // namespace clang::tidy::ttnn
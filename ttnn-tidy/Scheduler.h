@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_SCHEDULER_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_SCHEDULER_H_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+/// One translation unit to analyze.
+struct TUJob {
+  std::string File;
+  /// Estimated cost, only compared against other jobs.
+  uint64_t Cost = 0;
+  /// Precompiled preamble to load, or empty. All jobs of a batch share it.
+  std::string PCH;
+  /// Make-style dependency file listing the headers in the preamble.
+  std::string PCHDependencies;
+  /// Key of the job's entry in the result cache, or empty if not cached.
+  std::string CacheKey;
+  /// Estimated peak memory of the process analyzing this job, in bytes, or 0
+  /// when running without a memory budget.
+  uint64_t PeakMemory = 0;
+};
+
+/// Work-stealing scheduler for translation units.
+///
+/// Jobs are sorted longest first and dealt round-robin to one queue per
+/// worker, so the most expensive TUs start first and no worker ends up with
+/// one long tail job at the end. A worker takes batches from the front of its
+/// own queue; once that is empty it steals from the back of the most loaded
+/// other queue. A batch only ever holds jobs with the same preamble.
+class TUScheduler {
+public:
+  TUScheduler(std::vector<TUJob> Jobs, unsigned Workers);
+
+  /// Returns up to \p MaxJobs jobs for \p Worker, or an empty batch once all
+  /// queues are drained.
+  std::vector<TUJob> take(unsigned Worker, unsigned MaxJobs);
+
+private:
+  struct Queue {
+    std::mutex Mutex;
+    std::deque<TUJob> Jobs;
+    uint64_t Cost = 0; // remaining
+  };
+
+  bool steal(unsigned Worker, unsigned MaxJobs, std::vector<TUJob> &Batch);
+  static void takeBatch(Queue &Q, size_t MaxJobs, bool FromBack,
+                        std::vector<TUJob> &Batch);
+
+  std::vector<std::unique_ptr<Queue>> Queues;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_SCHEDULER_H_
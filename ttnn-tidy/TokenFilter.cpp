@@ -0,0 +1,401 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TokenFilter.h"
+#include "common/TtNNNames.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/ADT/bit.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <tuple>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+bool isIdentifierChar(char C) { return llvm::isAlnum(C) || C == '_'; }
+
+/// Matches \p Name against a clang-tidy glob, in which `*` matches any run of
+/// characters.
+bool matchesGlob(llvm::StringRef Glob, llvm::StringRef Name) {
+  size_t G = 0;
+  size_t N = 0;
+  size_t Star = llvm::StringRef::npos;
+  size_t StarName = 0;
+  while (N < Name.size()) {
+    if (G < Glob.size() && Glob[G] == '*') {
+      Star = G++;
+      StarName = N;
+    } else if (G < Glob.size() && Glob[G] == Name[N]) {
+      ++G;
+      ++N;
+    } else if (Star != llvm::StringRef::npos) {
+      G = Star + 1;
+      N = ++StarName;
+    } else {
+      return false;
+    }
+  }
+  while (G < Glob.size() && Glob[G] == '*') {
+    ++G;
+  }
+  return G == Glob.size();
+}
+
+struct CheckGlob {
+  bool Positive;
+  llvm::StringRef Pattern;
+};
+
+std::vector<CheckGlob> parseCheckGlobs(llvm::StringRef Checks) {
+  std::vector<CheckGlob> Globs;
+  llvm::SmallVector<llvm::StringRef, 8> Items;
+  Checks.split(Items, ',');
+  for (llvm::StringRef Item : Items) {
+    Item = Item.trim();
+    if (Item.empty()) {
+      continue;
+    }
+    bool Positive = !Item.consume_front("-");
+    Globs.push_back({Positive, Item.trim()});
+  }
+  return Globs;
+}
+
+bool isEnabledByGlobs(llvm::ArrayRef<CheckGlob> Globs,
+                      llvm::StringRef Check) {
+  // As in clang-tidy, the last glob that matches decides
+  for (const CheckGlob &G : llvm::reverse(Globs)) {
+    if (matchesGlob(G.Pattern, Check)) {
+      return G.Positive;
+    }
+  }
+  return false;
+}
+
+/// Returns the `#include` directive on \p Line, or std::nullopt if it has
+/// none or includes a macro.
+std::optional<IncludeDirective> getIncludeDirective(llvm::StringRef Line) {
+  Line = Line.ltrim();
+  if (!Line.consume_front("#")) {
+    return std::nullopt;
+  }
+  Line = Line.ltrim();
+  if (!Line.consume_front("include_next") && !Line.consume_front("include") &&
+      !Line.consume_front("import")) {
+    return std::nullopt;
+  }
+  Line = Line.ltrim();
+  if (Line.consume_front("\"")) {
+    return IncludeDirective{
+        Line.take_until([](char C) { return C == '"'; }).str(), false};
+  }
+  if (Line.consume_front("<")) {
+    return IncludeDirective{
+        Line.take_until([](char C) { return C == '>'; }).str(), true};
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+std::optional<std::vector<std::string>>
+getTriggerIdentifiers(llvm::StringRef Checks) {
+  std::vector<CheckGlob> Globs = parseCheckGlobs(Checks);
+
+  // Without a leading "-*" the checks enabled by .clang-tidy files still run;
+  // a positive glob outside ttnn-* may enable checks with unknown triggers
+  if (Globs.empty() || Globs.front().Positive ||
+      Globs.front().Pattern != "*") {
+    return std::nullopt;
+  }
+  for (const CheckGlob &G : Globs) {
+    if (G.Positive && !G.Pattern.starts_with("ttnn-")) {
+      return std::nullopt;
+    }
+  }
+
+  std::vector<std::string> Identifiers;
+  for (const TtNNCheckTriggers &Check : getTtNNCheckTriggers()) {
+    if (!isEnabledByGlobs(Globs, Check.Check)) {
+      continue;
+    }
+    for (llvm::StringRef Identifier : Check.Identifiers) {
+      if (!llvm::is_contained(Identifiers, Identifier)) {
+        Identifiers.push_back(Identifier.str());
+      }
+    }
+  }
+  return Identifiers;
+}
+
+bool isCheckEnabled(llvm::StringRef Checks, llvm::StringRef Check) {
+  return isEnabledByGlobs(parseCheckGlobs(Checks), Check);
+}
+
+IdentifierMatcher::IdentifierMatcher(std::vector<std::string> Identifiers)
+    : Identifiers(std::move(Identifiers)) {
+  llvm::erase_if(this->Identifiers, [](const std::string &Identifier) {
+    return Identifier.empty();
+  });
+  for (const std::string &Identifier : this->Identifiers) {
+    MaxLength = std::max(MaxLength, Identifier.size());
+  }
+}
+
+bool IdentifierMatcher::matchesAt(llvm::StringRef Buffer, size_t Pos,
+                                  const std::string &Identifier) const {
+  size_t End = Pos + Identifier.size();
+  return End <= Buffer.size() &&
+         std::memcmp(Buffer.data() + Pos, Identifier.data(),
+                     Identifier.size()) == 0 &&
+         (Pos == 0 || !isIdentifierChar(Buffer[Pos - 1])) &&
+         (End == Buffer.size() || !isIdentifierChar(Buffer[End]));
+}
+
+bool IdentifierMatcher::containsAny(llvm::StringRef Buffer) const {
+  if (Identifiers.empty()) {
+    return false;
+  }
+  const char *Data = Buffer.data();
+  size_t Pos = 0;
+
+#if defined(__SSE2__)
+  // Every load of a block stays inside the buffer; the rest is scanned below
+  for (; Pos + 16 + MaxLength - 1 <= Buffer.size(); Pos += 16) {
+    __m128i Block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(Data + Pos));
+    for (const std::string &Identifier : Identifiers) {
+      const char *LastBytes = Data + Pos + Identifier.size() - 1;
+      __m128i Last =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(LastBytes));
+      __m128i Candidates = _mm_and_si128(
+          _mm_cmpeq_epi8(Block, _mm_set1_epi8(Identifier.front())),
+          _mm_cmpeq_epi8(Last, _mm_set1_epi8(Identifier.back())));
+      unsigned Mask = static_cast<unsigned>(_mm_movemask_epi8(Candidates));
+      while (Mask) {
+        if (matchesAt(Buffer, Pos + llvm::countr_zero(Mask), Identifier)) {
+          return true;
+        }
+        Mask &= Mask - 1;
+      }
+    }
+  }
+#endif
+
+  for (; Pos < Buffer.size(); ++Pos) {
+    for (const std::string &Identifier : Identifiers) {
+      if (Data[Pos] == Identifier.front() &&
+          matchesAt(Buffer, Pos, Identifier)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+TokenPreFilter::TokenPreFilter(std::vector<std::string> Identifiers)
+    : Matcher(std::move(Identifiers)) {}
+
+std::vector<TUJob>
+TokenPreFilter::filter(std::vector<TUJob> Jobs,
+                       const tooling::CompilationDatabase &Database,
+                       unsigned Threads) {
+  // Jobs without a compile command are kept; clang-tidy reports on them
+  std::vector<std::optional<IncludeSearchPath>> Paths(Jobs.size());
+  for (size_t I = 0, E = Jobs.size(); I != E; ++I) {
+    std::vector<tooling::CompileCommand> Commands =
+        Database.getCompileCommands(Jobs[I].File);
+    if (!Commands.empty()) {
+      Paths[I] = getIncludeSearchPath(Commands.front());
+    }
+  }
+
+  std::vector<char> Keep(Jobs.size(), true);
+  std::atomic<size_t> Next{0};
+  std::vector<std::thread> Workers;
+  for (unsigned W = 0, E = std::max(Threads, 1u); W != E; ++W) {
+    Workers.emplace_back([&] {
+      for (size_t I = Next++; I < Jobs.size(); I = Next++) {
+        if (Paths[I]) {
+          Keep[I] = mayReport(Jobs[I].File, *Paths[I]);
+        }
+      }
+    });
+  }
+  for (std::thread &Worker : Workers) {
+    Worker.join();
+  }
+
+  std::vector<TUJob> Result;
+  for (size_t I = 0, E = Jobs.size(); I != E; ++I) {
+    if (Keep[I]) {
+      Result.push_back(std::move(Jobs[I]));
+    }
+  }
+  return Result;
+}
+
+IncludeSearchPath
+getIncludeSearchPath(const tooling::CompileCommand &Command) {
+  IncludeSearchPath Path;
+  std::vector<std::string> IncludeDirectories;
+  auto Absolute = [&](llvm::StringRef P) {
+    llvm::SmallString<256> Result(P);
+    llvm::sys::fs::make_absolute(Command.Directory, Result);
+    llvm::sys::path::remove_dots(Result, /*remove_dot_dot=*/true);
+    return std::string(Result);
+  };
+
+  const std::vector<std::string> &Args = Command.CommandLine;
+  for (size_t I = 1, E = Args.size(); I < E; ++I) {
+    llvm::StringRef Arg = Args[I];
+    if (Arg.starts_with("-include-pch")) {
+      continue;
+    }
+    for (auto [Flag, Into] :
+         {std::make_pair("-iquote", &Path.QuoteDirectories),
+          std::make_pair("-include", &Path.ForcedIncludes),
+          std::make_pair("-I", &IncludeDirectories)}) {
+      if (!Arg.consume_front(Flag)) {
+        continue;
+      }
+      if (Arg.empty() && I + 1 < E) {
+        Arg = Args[++I];
+      }
+      if (!Arg.empty()) {
+        Into->push_back(Absolute(Arg));
+      }
+      break;
+    }
+  }
+  // Quoted includes search -iquote before -I
+  llvm::append_range(Path.QuoteDirectories, IncludeDirectories);
+  return Path;
+}
+
+std::vector<IncludeDirective> getIncludeDirectives(llvm::StringRef Content) {
+  std::vector<IncludeDirective> Includes;
+  for (size_t Hash = Content.find('#'); Hash != llvm::StringRef::npos;
+       Hash = Content.find('#', Hash)) {
+    size_t LineStart = Content.rfind('\n', Hash) + 1;
+    size_t LineEnd = std::min(Content.find('\n', Hash), Content.size());
+    if (std::optional<IncludeDirective> Include =
+            getIncludeDirective(Content.slice(LineStart, LineEnd))) {
+      if (!Include->Target.empty()) {
+        Includes.push_back(std::move(*Include));
+      }
+    }
+    Hash = LineEnd;
+  }
+  return Includes;
+}
+
+std::vector<std::string> getQuotedIncludes(llvm::StringRef Content) {
+  std::vector<std::string> Includes;
+  for (IncludeDirective &Include : getIncludeDirectives(Content)) {
+    if (!Include.Angled) {
+      Includes.push_back(std::move(Include.Target));
+    }
+  }
+  return Includes;
+}
+
+std::string resolveQuotedInclude(llvm::StringRef IncludingFile,
+                                 llvm::StringRef Include,
+                                 const IncludeSearchPath &Path) {
+  if (llvm::sys::path::is_absolute(Include)) {
+    return Include.str();
+  }
+  auto Resolve = [&](llvm::StringRef SearchDirectory) {
+    llvm::SmallString<256> Resolved(SearchDirectory);
+    llvm::sys::path::append(Resolved, Include);
+    llvm::sys::path::remove_dots(Resolved, /*remove_dot_dot=*/true);
+    return llvm::sys::fs::exists(Resolved) ? std::string(Resolved)
+                                           : std::string();
+  };
+  // The first directory that has the header is the one clang uses
+  std::string Resolved = Resolve(llvm::sys::path::parent_path(IncludingFile));
+  for (size_t I = 0, E = Path.QuoteDirectories.size();
+       Resolved.empty() && I != E; ++I) {
+    Resolved = Resolve(Path.QuoteDirectories[I]);
+  }
+  return Resolved;
+}
+
+bool TokenPreFilter::mayReport(llvm::StringRef File,
+                               const IncludeSearchPath &Path) {
+  const ScannedFile *Main = scan(File);
+  if (!Main) {
+    return true; // let clang-tidy report the error
+  }
+
+  llvm::StringSet<> Visited;
+  std::vector<std::string> Worklist = {File.str()};
+  llvm::append_range(Worklist, Path.ForcedIncludes);
+  while (!Worklist.empty()) {
+    std::string Current = Worklist.back();
+    Worklist.pop_back();
+    if (!Visited.insert(Current).second) {
+      continue;
+    }
+    const ScannedFile *Scanned = scan(Current);
+    if (!Scanned) {
+      continue;
+    }
+    if (Scanned->HasIdentifier) {
+      return true;
+    }
+
+    for (const std::string &Include : Scanned->QuotedIncludes) {
+      std::string Resolved = resolveQuotedInclude(Current, Include, Path);
+      if (!Resolved.empty()) {
+        Worklist.push_back(std::move(Resolved));
+      }
+    }
+  }
+  return false;
+}
+
+const TokenPreFilter::ScannedFile *
+TokenPreFilter::scan(llvm::StringRef Path) {
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto It = Files.find(Path);
+    if (It != Files.end()) {
+      return It->second.get();
+    }
+  }
+
+  std::unique_ptr<ScannedFile> Scanned;
+  if (llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+          llvm::MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                      /*RequiresNullTerminator=*/false)) {
+    llvm::StringRef Content = (*Buffer)->getBuffer();
+    Scanned = std::make_unique<ScannedFile>();
+    Scanned->HasIdentifier = Matcher.containsAny(Content);
+    // Includes only matter while no identifier has been found
+    if (!Scanned->HasIdentifier) {
+      Scanned->QuotedIncludes = getQuotedIncludes(Content);
+    }
+  }
+
+  // Concurrent scans of the same file agree, so the first one is kept
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return Files.try_emplace(Path, std::move(Scanned)).first->second.get();
+}
+
+} // namespace clang::tidy::ttnn
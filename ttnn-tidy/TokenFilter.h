@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_TOKENFILTER_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_TOKENFILTER_H_
+
+#include "Scheduler.h"
+#include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+/// Returns the identifiers of the TTNN checks enabled by the clang-tidy check
+/// glob \p Checks. Returns std::nullopt if the glob may enable checks that are
+/// not TTNN checks, including any enabled by `.clang-tidy` files, because
+/// then any translation unit may produce a diagnostic.
+std::optional<std::vector<std::string>>
+getTriggerIdentifiers(llvm::StringRef Checks);
+
+/// Returns true if the clang-tidy check glob \p Checks enables \p Check. Any
+/// `.clang-tidy` files are not taken into account.
+bool isCheckEnabled(llvm::StringRef Checks, llvm::StringRef Check);
+
+/// Where the quoted includes of a translation unit are looked up.
+struct IncludeSearchPath {
+  std::vector<std::string> QuoteDirectories; // -iquote, then -I
+  std::vector<std::string> ForcedIncludes;   // -include
+};
+
+/// Returns the include search path of \p Command, with absolute paths.
+IncludeSearchPath getIncludeSearchPath(const tooling::CompileCommand &Command);
+
+/// An `#include` directive, without its delimiters.
+struct IncludeDirective {
+  std::string Target;
+  bool Angled = false;
+};
+
+/// Returns the `#include` directives in \p Content, in order. Directives
+/// that include a macro are left out.
+std::vector<IncludeDirective> getIncludeDirectives(llvm::StringRef Content);
+
+/// Returns the targets of the `#include "..."` directives in \p Content.
+std::vector<std::string> getQuotedIncludes(llvm::StringRef Content);
+
+/// Resolves the quoted include \p Include of \p IncludingFile the way clang
+/// does: next to the including file, then in the directories of \p Path.
+/// Returns an empty string if no file is found.
+std::string resolveQuotedInclude(llvm::StringRef IncludingFile,
+                                 llvm::StringRef Include,
+                                 const IncludeSearchPath &Path);
+
+/// Finds whole identifiers from a fixed set in a buffer.
+///
+/// Each 16-byte block is compared against the first and the last byte of
+/// every identifier with SSE2, and only positions where both match are
+/// compared in full. Without SSE2 the same test runs one byte at a time.
+class IdentifierMatcher {
+public:
+  explicit IdentifierMatcher(std::vector<std::string> Identifiers);
+
+  /// Returns true if \p Buffer spells one of the identifiers, not as part of
+  /// a longer identifier.
+  bool containsAny(llvm::StringRef Buffer) const;
+
+private:
+  bool matchesAt(llvm::StringRef Buffer, size_t Pos,
+                 const std::string &Identifier) const;
+
+  std::vector<std::string> Identifiers;
+  size_t MaxLength = 0;
+};
+
+/// Drops translation units that cannot produce a diagnostic before any of
+/// them is parsed: those whose main file, forced includes and the quoted
+/// includes they reach spell none of the trigger identifiers.
+///
+/// Quoted includes are resolved the way clang does, next to the including
+/// file and then in the `-iquote` and `-I` directories. Includes that resolve
+/// elsewhere, and all angled includes, are taken to be third-party headers
+/// and not scanned. Each file is read once per run.
+class TokenPreFilter {
+public:
+  explicit TokenPreFilter(std::vector<std::string> Identifiers);
+
+  /// Returns the jobs of \p Jobs that may produce a diagnostic, scanning
+  /// with \p Threads threads.
+  std::vector<TUJob> filter(std::vector<TUJob> Jobs,
+                            const tooling::CompilationDatabase &Database,
+                            unsigned Threads);
+
+private:
+  struct ScannedFile {
+    bool HasIdentifier = false;
+    std::vector<std::string> QuotedIncludes;
+  };
+
+  /// Returns true if \p File or a quoted include it reaches spells one of
+  /// the identifiers.
+  bool mayReport(llvm::StringRef File, const IncludeSearchPath &Path);
+
+  /// Returns the scan of \p Path, or nullptr if it cannot be read.
+  const ScannedFile *scan(llvm::StringRef Path);
+
+  IdentifierMatcher Matcher;
+  std::mutex Mutex;
+  llvm::StringMap<std::unique_ptr<ScannedFile>> Files;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_TOKENFILTER_H_
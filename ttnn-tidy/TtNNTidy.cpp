@@ -0,0 +1,986 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Parallel runner for the TTNN checks.
+//
+// Reads compile_commands.json, schedules the translation units longest first
+// over a work-stealing pool of workers and merges every diagnostic and fix
+// into one export-fixes file:
+//
+//   ttnn-tidy -p build -j 32 -export-fixes=ttnn-fixes.yaml
+//
+// clang-tidy's own libraries are not part of the Clang packages this repo
+// builds against, so the checks cannot be linked into this executable. Each
+// worker instead runs batches of translation units through one clang-tidy
+// process that loads TtNNChecks.so once and runs every enabled check in a
+// single pass, and the results are merged in memory.
+//
+// Translation units that share compile flags and a leading run of includes
+// share one precompiled header of that prefix, built once before the run, so
+// each of them only parses its own body.
+//
+// With -cache-dir, the results of every translation unit are stored together
+// with the content hashes of all files it read, as recorded by the plugin.
+// Later runs replay the results of unchanged translation units without
+// starting clang-tidy for them at all.
+//
+// Translation units whose main file and project headers spell none of the
+// identifiers the enabled checks look for are dropped before anything is
+// parsed.
+//
+// With -export-replacements, the fixes are also written as one compact
+// binary replacements file for ttnn-apply-fixes, which applies them much
+// faster than clang-apply-replacements parses the YAML.
+//
+// With -types-headers, the *_device_operation_types.hpp headers are checked
+// with the lexer alone instead, without a compilation database or a parse.
+//
+// With -header-tus, every *_device_operation_types.hpp header that the
+// selected translation units include is analyzed instead, as the main file of
+// its own translation unit, with the flags of a source file that includes it.
+//
+// With -memory-budget, a batch is only started while the peak memory of the
+// running batches, estimated from the peaks recorded in earlier runs, leaves
+// room for its own.
+
+#include "MemoryBudget.h"
+#include "HeaderTUs.h"
+#include "Preamble.h"
+#include "ResultCache.h"
+#include "Scheduler.h"
+#include "TokenFilter.h"
+#include "TypesHeaderScanner.h"
+#include "common/TtNNDependencyRecorder.h"
+#include "common/TtNNNames.h"
+#include "common/TtNNReplacements.h"
+#include "clang/Tooling/Core/Diagnostic.h"
+#include "clang/Tooling/DiagnosticsYaml.h"
+#include "clang/Tooling/JSONCompilationDatabase.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Program.h"
+#include "llvm/Support/Regex.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/YAMLParser.h"
+#include "llvm/Support/YAMLTraits.h"
+#include "llvm/Support/xxhash.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#ifndef TTNN_CLANG_TIDY
+#define TTNN_CLANG_TIDY "clang-tidy"
+#endif
+#ifndef TTNN_CLANG
+#define TTNN_CLANG "clang++"
+#endif
+
+using namespace clang;
+using namespace clang::tidy::ttnn;
+
+namespace {
+
+llvm::cl::OptionCategory TtNNTidyCategory("ttnn-tidy options");
+
+llvm::cl::list<std::string> FileFilters(
+    llvm::cl::Positional,
+    llvm::cl::desc("[<file regex>...] (default: every file in the database)"),
+    llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string>
+    BuildPath("p", llvm::cl::desc("Directory containing compile_commands.json"),
+              llvm::cl::init("."), llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<unsigned>
+    Jobs("j", llvm::cl::desc("Number of workers (default: all cores)"),
+         llvm::cl::init(0), llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<unsigned> BatchSize(
+    "batch-size",
+    llvm::cl::desc("Translation units handed to one clang-tidy process"),
+    llvm::cl::init(8), llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string>
+    Checks("checks", llvm::cl::desc("Checks to run, as for clang-tidy"),
+           llvm::cl::init("-*,ttnn-*"), llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string>
+    Config("config", llvm::cl::desc("Configuration passed to clang-tidy"),
+           llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string>
+    HeaderFilter("header-filter",
+                 llvm::cl::desc("Header filter passed to clang-tidy"),
+                 llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::list<std::string>
+    ExtraArgs("extra-arg",
+              llvm::cl::desc("Additional argument to append to the compiler "
+                             "command line"),
+              llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string>
+    ExportFixes("export-fixes",
+                llvm::cl::desc("YAML file to store all diagnostics and fixes "
+                               "in, for clang-apply-replacements"),
+                llvm::cl::value_desc("file"), llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string> ExportReplacements(
+    "export-replacements",
+    llvm::cl::desc("Compact replacements file to store all fixes in, for "
+                   "ttnn-apply-fixes"),
+    llvm::cl::value_desc("file"), llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string> PluginPath(
+    "plugin",
+    llvm::cl::desc("TtNNChecks.so to load (default: next to ttnn-tidy, in "
+                   "its build tree or in ../lib)"),
+    llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string>
+    ClangTidyBinary("clang-tidy-binary",
+                    llvm::cl::desc("clang-tidy executable to run"),
+                    llvm::cl::init(TTNN_CLANG_TIDY),
+                    llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<bool>
+    SharePreambles("pch",
+                   llvm::cl::desc("Build one precompiled header per shared "
+                                  "include prefix and reuse it across "
+                                  "translation units"),
+                   llvm::cl::init(true), llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<unsigned> PreambleMinTUs(
+    "pch-min-tus",
+    llvm::cl::desc("Smallest number of translation units worth a shared PCH"),
+    llvm::cl::init(2), llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string>
+    PreambleDirectory("pch-dir",
+                      llvm::cl::desc("Directory for the shared PCHs (default: "
+                                     "a temporary directory, removed after "
+                                     "the run)"),
+                      llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string>
+    ClangBinary("clang-binary",
+                llvm::cl::desc("clang++ used to build the shared PCHs; must "
+                               "match the clang-tidy version"),
+                llvm::cl::init(TTNN_CLANG), llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string>
+    CacheDirectory("cache-dir",
+                   llvm::cl::desc("Directory for stored results; translation "
+                                  "units whose inputs did not change are "
+                                  "replayed from it"),
+                   llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<bool>
+    PreFilter("prefilter",
+              llvm::cl::desc("Skip translation units that spell none of the "
+                             "identifiers the enabled checks look for"),
+              llvm::cl::init(true), llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<bool> HeaderTUsOption(
+    "header-tus",
+    llvm::cl::desc("Analyze each *_device_operation_types.hpp header the "
+                   "selected translation units include as the main file of "
+                   "its own translation unit, with borrowed flags"),
+    llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string> MemoryBudgetOption(
+    "memory-budget",
+    llvm::cl::desc("Only start a batch while the estimated peak memory of "
+                   "all running batches stays within this size, e.g. 48G"),
+    llvm::cl::value_desc("size"), llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string> MemoryEstimate(
+    "memory-estimate",
+    llvm::cl::desc("Peak memory assumed for a translation unit with no "
+                   "recorded peak while nothing is recorded at all"),
+    llvm::cl::value_desc("size"), llvm::cl::init("4G"),
+    llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::opt<std::string> MemoryHistoryPath(
+    "memory-history",
+    llvm::cl::desc("File recording the peak memory of every translation unit "
+                   "for later runs (default: in -cache-dir)"),
+    llvm::cl::value_desc("file"), llvm::cl::cat(TtNNTidyCategory));
+
+llvm::cl::list<std::string> TypesHeaders(
+    "types-headers",
+    llvm::cl::desc("Check the *_device_operation_types.hpp headers in these "
+                   "files and directories with the lexer only, without a "
+                   "compilation database"),
+    llvm::cl::value_desc("path"), llvm::cl::CommaSeparated,
+    llvm::cl::cat(TtNNTidyCategory));
+
+/// Merges the diagnostics of all batches, dropping the copies reported by
+/// every translation unit that includes the same header.
+class ResultMerger {
+public:
+  void add(std::vector<tooling::Diagnostic> Diagnostics) {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    for (tooling::Diagnostic &D : Diagnostics) {
+      std::string Key = (D.DiagnosticName + "\x1f" + D.Message.FilePath +
+                         "\x1f" + llvm::Twine(D.Message.FileOffset) + "\x1f" +
+                         D.Message.Message)
+                            .str();
+      if (Seen.insert(Key).second) {
+        Merged.push_back(std::move(D));
+      }
+    }
+  }
+
+  size_t size() const { return Merged.size(); }
+
+  /// Writes the fix of every diagnostic, as clang-apply-replacements would
+  /// pick it, to the compact replacements file \p Path.
+  bool writeReplacements(llvm::StringRef Path) {
+    sort();
+    CompactReplacementsWriter Writer;
+    for (const tooling::Diagnostic &D : Merged) {
+      const llvm::StringMap<tooling::Replacements> *Fix =
+          tooling::selectFirstFix(D);
+      if (!Fix) {
+        continue;
+      }
+      for (const auto &[File, Replacements] : *Fix) {
+        for (const tooling::Replacement &R : Replacements) {
+          Writer.add(R.getFilePath(), R.getOffset(), R.getLength(),
+                     R.getReplacementText());
+        }
+      }
+    }
+    if (llvm::Error Err = Writer.write(Path)) {
+      llvm::WithColor::error() << llvm::toString(std::move(Err)) << '\n';
+      return false;
+    }
+    return true;
+  }
+
+  bool write(llvm::StringRef Path) {
+    sort();
+
+    std::error_code EC;
+    llvm::ToolOutputFile Out(Path, EC, llvm::sys::fs::OF_Text);
+    if (EC) {
+      llvm::WithColor::error() << Path << ": " << EC.message() << '\n';
+      return false;
+    }
+    tooling::TranslationUnitDiagnostics Result;
+    Result.Diagnostics = std::move(Merged);
+    llvm::yaml::Output YAML(Out.os());
+    YAML << Result;
+    Out.keep();
+    Merged = std::move(Result.Diagnostics);
+    return true;
+  }
+
+private:
+  // Output does not depend on the order the batches finished in
+  void sort() {
+    llvm::sort(Merged, [](const tooling::Diagnostic &A,
+                          const tooling::Diagnostic &B) {
+      return std::tie(A.Message.FilePath, A.Message.FileOffset,
+                      A.DiagnosticName, A.Message.Message) <
+             std::tie(B.Message.FilePath, B.Message.FileOffset,
+                      B.DiagnosticName, B.Message.Message);
+    });
+  }
+
+  std::mutex Mutex;
+  llvm::StringSet<> Seen;
+  std::vector<tooling::Diagnostic> Merged;
+};
+
+std::string findPlugin(const char *Argv0) {
+  if (!PluginPath.empty()) {
+    return PluginPath;
+  }
+  static int Anchor;
+  std::string Executable = llvm::sys::fs::getMainExecutable(Argv0, &Anchor);
+  llvm::StringRef Dir = llvm::sys::path::parent_path(Executable);
+  // Installed side by side, in the build tree, or installed under lib/
+  for (llvm::StringRef Relative : {"", "..", "../lib"}) {
+    llvm::SmallString<256> Candidate(Dir);
+    llvm::sys::path::append(Candidate, Relative, "TtNNChecks.so");
+    if (llvm::sys::fs::exists(Candidate)) {
+      return std::string(Candidate);
+    }
+  }
+  return "";
+}
+
+/// Returns what, besides the translation unit itself, decides its results:
+/// the clang-tidy and plugin builds and the check options. Empty if a binary
+/// cannot be read.
+std::string getRunIdentity(llvm::StringRef ClangTidy, llvm::StringRef Plugin) {
+  std::string Identity = "ttnn-tidy-result 1\n";
+  for (llvm::StringRef Binary : {ClangTidy, Plugin}) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+        llvm::MemoryBuffer::getFile(Binary, /*IsText=*/false,
+                                    /*RequiresNullTerminator=*/false);
+    if (!Buffer) {
+      return "";
+    }
+    Identity += "binary=" +
+                llvm::utohexstr(llvm::xxHash64((*Buffer)->getBuffer())) + "\n";
+  }
+  Identity += "checks=" + Checks + "\nconfig=" + Config +
+              "\nheader-filter=" + HeaderFilter + "\n";
+  for (const std::string &Arg : ExtraArgs) {
+    Identity += "extra-arg=" + Arg + "\n";
+  }
+  return Identity;
+}
+
+/// Prints \p D in clang-tidy's format, without the source excerpt.
+void printDiagnostic(llvm::raw_ostream &OS, const tooling::Diagnostic &D) {
+  const tooling::DiagnosticMessage &Message = D.Message;
+  size_t Line = 0;
+  size_t Column = 0;
+  if (llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+          llvm::MemoryBuffer::getFile(Message.FilePath)) {
+    llvm::StringRef Before =
+        (*Buffer)->getBuffer().take_front(Message.FileOffset);
+    Line = Before.count('\n') + 1;
+    Column = Before.size() - (Before.rfind('\n') + 1) + 1;
+  }
+
+  llvm::StringRef Level = "warning";
+  if (D.DiagLevel == tooling::Diagnostic::Error) {
+    Level = "error";
+  } else if (D.DiagLevel == tooling::Diagnostic::Remark) {
+    Level = "remark";
+  }
+  OS << Message.FilePath << ':' << Line << ':' << Column << ": " << Level
+     << ": " << Message.Message << " [" << D.DiagnosticName << "]\n";
+}
+
+std::vector<TUJob> collectJobs(const tooling::CompilationDatabase &Database) {
+  std::vector<llvm::Regex> Filters;
+  for (const std::string &Filter : FileFilters) {
+    Filters.emplace_back(Filter);
+  }
+
+  std::vector<TUJob> Result;
+  llvm::StringSet<> Seen;
+  for (const std::string &File : Database.getAllFiles()) {
+    if (!Seen.insert(File).second) {
+      continue;
+    }
+    if (!Filters.empty() && llvm::none_of(Filters, [&](const llvm::Regex &R) {
+          return R.match(File);
+        })) {
+      continue;
+    }
+    // The main file size is a cheap stand-in for the cost of a TTNN TU; the
+    // big shared headers cost roughly the same everywhere.
+    uint64_t Size = 0;
+    llvm::sys::fs::file_size(File, Size);
+    Result.push_back({File, Size});
+  }
+  return Result;
+}
+
+/// Replays the stored results of every job in \p Jobs whose inputs did not
+/// change into \p Merger, and returns the others.
+std::vector<TUJob> replayCachedResults(
+    std::vector<TUJob> Jobs, const tooling::CompilationDatabase &Database,
+    ResultCache &Cache, ResultMerger &Merger, unsigned Threads) {
+  for (TUJob &Job : Jobs) {
+    std::vector<tooling::CompileCommand> Commands =
+        Database.getCompileCommands(Job.File);
+    if (!Commands.empty()) {
+      Job.CacheKey = Cache.getKey(Job.File, Commands.front());
+    }
+  }
+
+  // Headers are hashed once and shared by all lookups
+  std::vector<std::optional<std::vector<tooling::Diagnostic>>> Results(
+      Jobs.size());
+  std::atomic<size_t> Next{0};
+  std::vector<std::thread> Workers;
+  for (unsigned W = 0, E = std::max(Threads, 1u); W != E; ++W) {
+    Workers.emplace_back([&] {
+      for (size_t I = Next++; I < Jobs.size(); I = Next++) {
+        if (!Jobs[I].CacheKey.empty()) {
+          Results[I] = Cache.lookup(Jobs[I].CacheKey);
+        }
+      }
+    });
+  }
+  for (std::thread &Worker : Workers) {
+    Worker.join();
+  }
+
+  std::vector<TUJob> Misses;
+  for (size_t I = 0, E = Jobs.size(); I != E; ++I) {
+    if (!Results[I]) {
+      Misses.push_back(std::move(Jobs[I]));
+      continue;
+    }
+    for (const tooling::Diagnostic &D : *Results[I]) {
+      printDiagnostic(llvm::outs(), D);
+    }
+    Merger.add(std::move(*Results[I]));
+  }
+  return Misses;
+}
+
+/// Returns the value that \p Check's option \p Name takes in the -config
+/// string: the check's own value, else the global one, as clang-tidy's
+/// getLocalOrGlobal() resolves it. CheckOptions may be a mapping or, as in
+/// older configurations, a list of key/value pairs.
+std::optional<std::string> getConfigOption(llvm::StringRef Check,
+                                           llvm::StringRef Name) {
+  if (Config.empty()) {
+    return std::nullopt;
+  }
+
+  llvm::StringMap<std::string> Options;
+  auto Add = [&](llvm::yaml::Node *Key, llvm::yaml::Node *Value) {
+    auto *KeyScalar = llvm::dyn_cast_or_null<llvm::yaml::ScalarNode>(Key);
+    auto *ValueScalar = llvm::dyn_cast_or_null<llvm::yaml::ScalarNode>(Value);
+    if (KeyScalar && ValueScalar) {
+      llvm::SmallString<64> KeyStorage;
+      llvm::SmallString<256> ValueStorage;
+      Options[KeyScalar->getValue(KeyStorage)] =
+          ValueScalar->getValue(ValueStorage).str();
+    }
+  };
+  auto getName = [](llvm::yaml::Node *Key) -> std::string {
+    auto *Scalar = llvm::dyn_cast_or_null<llvm::yaml::ScalarNode>(Key);
+    llvm::SmallString<32> Storage;
+    return Scalar ? Scalar->getValue(Storage).str() : "";
+  };
+
+  // clang-tidy reports a malformed configuration itself
+  llvm::SourceMgr SourceManager;
+  SourceManager.setDiagHandler([](const llvm::SMDiagnostic &, void *) {});
+  llvm::yaml::Stream Stream(Config, SourceManager);
+  for (llvm::yaml::Document &Document : Stream) {
+    auto *Root =
+        llvm::dyn_cast_or_null<llvm::yaml::MappingNode>(Document.getRoot());
+    if (!Root) {
+      continue;
+    }
+    for (llvm::yaml::KeyValueNode &Entry : *Root) {
+      if (getName(Entry.getKey()) != "CheckOptions") {
+        continue;
+      }
+      llvm::yaml::Node *Value = Entry.getValue();
+      if (auto *Map = llvm::dyn_cast_or_null<llvm::yaml::MappingNode>(Value)) {
+        for (llvm::yaml::KeyValueNode &Option : *Map) {
+          // Nodes are parsed in order, so the key must be read first
+          llvm::yaml::Node *OptionKey = Option.getKey();
+          Add(OptionKey, Option.getValue());
+        }
+      } else if (auto *List =
+                     llvm::dyn_cast_or_null<llvm::yaml::SequenceNode>(Value)) {
+        for (llvm::yaml::Node &Item : *List) {
+          auto *Pair = llvm::dyn_cast<llvm::yaml::MappingNode>(&Item);
+          if (!Pair) {
+            continue;
+          }
+          llvm::yaml::Node *OptionKey = nullptr;
+          llvm::yaml::Node *OptionValue = nullptr;
+          for (llvm::yaml::KeyValueNode &Field : *Pair) {
+            std::string FieldName = getName(Field.getKey());
+            if (FieldName == "key") {
+              OptionKey = Field.getValue();
+            } else if (FieldName == "value") {
+              OptionValue = Field.getValue();
+            }
+          }
+          Add(OptionKey, OptionValue);
+        }
+      }
+    }
+  }
+
+  auto Local = Options.find((Check + "." + Name).str());
+  if (Local != Options.end()) {
+    return Local->second;
+  }
+  auto Global = Options.find(Name);
+  if (Global != Options.end()) {
+    return Global->second;
+  }
+  return std::nullopt;
+}
+
+/// Runs the declaration-side checks over the types headers in -types-headers
+/// with the lexer alone. Returns the process exit code.
+int checkTypesHeaders(unsigned Threads) {
+  // Only the naming check resolves operations
+  TypesHeaderScanner Scanner(
+      isCheckEnabled(Checks, kReturnValueTypeAliasCheckName),
+      isCheckEnabled(Checks, kOperationTypeNamingCheckName),
+      getConfigOption(kOperationTypeNamingCheckName, "CategoryNamespaces")
+          .value_or(kDefaultCategoryNamespaces));
+  std::vector<std::string> Headers = findTypesHeaders(TypesHeaders);
+
+  std::vector<std::vector<tooling::Diagnostic>> Results(Headers.size());
+  std::atomic<size_t> Next{0};
+  std::atomic<unsigned> Failures{0};
+  std::vector<std::thread> Workers;
+  for (unsigned W = 0, E = std::max(Threads, 1u); W != E; ++W) {
+    Workers.emplace_back([&] {
+      for (size_t I = Next++; I < Headers.size(); I = Next++) {
+        llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Content =
+            llvm::MemoryBuffer::getFile(Headers[I], /*IsText=*/false,
+                                        /*RequiresNullTerminator=*/false);
+        if (!Content) {
+          ++Failures;
+          continue;
+        }
+        Results[I] = Scanner.scan(Headers[I], (*Content)->getBuffer());
+      }
+    });
+  }
+  for (std::thread &Worker : Workers) {
+    Worker.join();
+  }
+
+  // Printed in path order so the output does not depend on the schedule
+  ResultMerger Merger;
+  for (std::vector<tooling::Diagnostic> &Diagnostics : Results) {
+    for (const tooling::Diagnostic &D : Diagnostics) {
+      printDiagnostic(llvm::outs(), D);
+    }
+    Merger.add(std::move(Diagnostics));
+  }
+  if (Failures) {
+    llvm::WithColor::error() << Failures
+                             << " types headers could not be read\n";
+  }
+
+  if (!ExportFixes.empty() && !Merger.write(ExportFixes)) {
+    return 1;
+  }
+  if (!ExportReplacements.empty() &&
+      !Merger.writeReplacements(ExportReplacements)) {
+    return 1;
+  }
+  llvm::errs() << Merger.size() << " diagnostics from " << Headers.size()
+               << " types headers\n";
+  return Failures ? 1 : 0;
+}
+
+class BatchRunner {
+public:
+  BatchRunner(std::string ClangTidy, std::string Plugin,
+              std::string DatabaseDirectory, ResultMerger &Merger,
+              ResultCache *Cache, PeakMemoryHistory *History)
+      : ClangTidy(std::move(ClangTidy)), Plugin(std::move(Plugin)),
+        DatabaseDirectory(std::move(DatabaseDirectory)), Merger(Merger),
+        Cache(Cache), History(History) {}
+
+  /// Runs clang-tidy over \p Batch. Returns false if it failed.
+  bool run(const std::vector<TUJob> &Batch) {
+    llvm::SmallString<128> FixesPath;
+    llvm::SmallString<128> LogPath;
+    if (llvm::sys::fs::createTemporaryFile("ttnn-tidy", "yaml", FixesPath) ||
+        llvm::sys::fs::createTemporaryFile("ttnn-tidy", "log", LogPath)) {
+      llvm::WithColor::error() << "cannot create temporary files\n";
+      return false;
+    }
+    // clang-tidy only writes the fixes file when there is something in it
+    llvm::sys::fs::remove(FixesPath);
+
+    std::vector<std::string> Args = {
+        ClangTidy,
+        "-load=" + Plugin,
+        "-p=" + DatabaseDirectory,
+        "-checks=" + Checks,
+        ("-export-fixes=" + FixesPath).str(),
+        "-quiet",
+    };
+    if (!Config.empty()) {
+      Args.push_back("-config=" + Config);
+    }
+    if (!HeaderFilter.empty()) {
+      Args.push_back("-header-filter=" + HeaderFilter);
+    }
+    for (const std::string &Arg : ExtraArgs) {
+      Args.push_back("-extra-arg=" + Arg);
+    }
+    // The scheduler only batches jobs with the same preamble
+    if (!Batch.front().PCH.empty()) {
+      Args.push_back("-extra-arg=-include-pch");
+      Args.push_back("-extra-arg=" + Batch.front().PCH);
+    }
+    for (const TUJob &Job : Batch) {
+      Args.push_back(Job.File);
+    }
+
+    std::vector<llvm::StringRef> ArgRefs(Args.begin(), Args.end());
+    std::optional<llvm::StringRef> Redirects[] = {
+        std::nullopt, llvm::StringRef(LogPath), llvm::StringRef(LogPath)};
+    std::string ErrMsg;
+    std::optional<llvm::sys::ProcessStatistics> Statistics;
+    int ExitCode = llvm::sys::ExecuteAndWait(
+        ClangTidy, ArgRefs, std::nullopt, Redirects, 0, 0, &ErrMsg,
+        /*ExecutionFailed=*/nullptr, &Statistics);
+    // A process that crashed may have stopped short of its real peak
+    if (History && Statistics && ExitCode == 0) {
+      History->record(Batch, Statistics->PeakMemory * 1024);
+    }
+
+    std::vector<tooling::Diagnostic> Diagnostics;
+    bool Complete = ExitCode == 0;
+    if (llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Fixes =
+            llvm::MemoryBuffer::getFile(FixesPath)) {
+      tooling::TranslationUnitDiagnostics TUD;
+      llvm::yaml::Input YAML((*Fixes)->getBuffer());
+      YAML >> TUD;
+      if (YAML.error()) {
+        Complete = false;
+        llvm::WithColor::warning()
+            << "cannot parse the fixes of " << Batch.front().File << "\n";
+      } else {
+        Diagnostics = std::move(TUD.Diagnostics);
+      }
+    }
+    // Failed batches are analyzed again next time rather than stored
+    if (Cache && Complete) {
+      for (const TUJob &Job : Batch) {
+        Cache->store(Job, Diagnostics);
+      }
+    }
+    Merger.add(std::move(Diagnostics));
+
+    // Whole batches are printed at once so outputs do not interleave
+    {
+      std::lock_guard<std::mutex> Lock(OutputMutex);
+      Done += Batch.size();
+      if (llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Log =
+              llvm::MemoryBuffer::getFile(LogPath)) {
+        llvm::outs() << (*Log)->getBuffer();
+      }
+      if (ExitCode < 0) {
+        llvm::WithColor::error() << ClangTidy << ": " << ErrMsg << '\n';
+      }
+      llvm::errs() << "[" << Done << "/" << Total << "] "
+                   << llvm::sys::path::filename(Batch.back().File) << '\n';
+    }
+
+    llvm::sys::fs::remove(FixesPath);
+    llvm::sys::fs::remove(LogPath);
+    return ExitCode == 0;
+  }
+
+  size_t Total = 0;
+
+private:
+  std::string ClangTidy;
+  std::string Plugin;
+  std::string DatabaseDirectory;
+  ResultMerger &Merger;
+  ResultCache *Cache;
+  PeakMemoryHistory *History;
+  std::mutex OutputMutex;
+  size_t Done = 0;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  llvm::InitLLVM X(argc, argv);
+  llvm::cl::HideUnrelatedOptions(TtNNTidyCategory);
+  llvm::cl::ParseCommandLineOptions(argc, argv,
+                                    "Runs the TTNN checks over a compilation "
+                                    "database in parallel\n");
+
+  if (!TypesHeaders.empty()) {
+    return checkTypesHeaders(
+        Jobs ? Jobs.getValue()
+             : llvm::hardware_concurrency().compute_thread_count());
+  }
+
+  std::string ErrorMessage;
+  std::unique_ptr<tooling::JSONCompilationDatabase> Database =
+      tooling::JSONCompilationDatabase::loadFromDirectory(BuildPath,
+                                                          ErrorMessage);
+  if (!Database) {
+    llvm::WithColor::error() << ErrorMessage << '\n';
+    return 1;
+  }
+
+  std::string Plugin = findPlugin(argv[0]);
+  if (Plugin.empty()) {
+    llvm::WithColor::error() << "cannot find TtNNChecks.so; use -plugin\n";
+    return 1;
+  }
+  llvm::ErrorOr<std::string> ClangTidy =
+      llvm::sys::findProgramByName(ClangTidyBinary);
+  if (!ClangTidy) {
+    llvm::WithColor::error() << "cannot find " << ClangTidyBinary
+                             << "; use -clang-tidy-binary\n";
+    return 1;
+  }
+
+  std::optional<MemoryBudget> Budget;
+  std::optional<uint64_t> Estimate = parseMemorySize(MemoryEstimate);
+  if (!MemoryBudgetOption.empty()) {
+    std::optional<uint64_t> Limit = parseMemorySize(MemoryBudgetOption);
+    if (!Limit || !*Limit) {
+      llvm::WithColor::error()
+          << "invalid -memory-budget '" << MemoryBudgetOption << "'\n";
+      return 1;
+    }
+    if (!Estimate || !*Estimate) {
+      llvm::WithColor::error()
+          << "invalid -memory-estimate '" << MemoryEstimate << "'\n";
+      return 1;
+    }
+    Budget.emplace(*Limit);
+  }
+
+  std::vector<TUJob> Work = collectJobs(*Database);
+  unsigned Workers =
+      Jobs ? Jobs.getValue()
+           : llvm::hardware_concurrency().compute_thread_count();
+
+  // The types headers replace the translation units that include them. Each
+  // becomes an entry of a database of its own, which every later step reads.
+  std::string DatabaseDirectory = BuildPath;
+  llvm::SmallString<256> HeaderDirectory;
+  if (HeaderTUsOption) {
+    std::vector<HeaderTU> Headers = findHeaderTUs(Work, *Database, Workers);
+    if (std::error_code EC = llvm::sys::fs::createUniqueDirectory(
+            "ttnn-tidy-headers", HeaderDirectory)) {
+      llvm::WithColor::error() << "cannot create a temporary directory: "
+                               << EC.message() << '\n';
+      return 1;
+    }
+    if (llvm::Error Err =
+            writeHeaderDatabase(Headers, *Database, HeaderDirectory)) {
+      llvm::WithColor::error() << llvm::toString(std::move(Err)) << '\n';
+      llvm::sys::fs::remove_directories(HeaderDirectory);
+      return 1;
+    }
+    Database = tooling::JSONCompilationDatabase::loadFromDirectory(
+        HeaderDirectory, ErrorMessage);
+    if (!Database) {
+      llvm::WithColor::error() << ErrorMessage << '\n';
+      llvm::sys::fs::remove_directories(HeaderDirectory);
+      return 1;
+    }
+    DatabaseDirectory = std::string(HeaderDirectory);
+
+    Work.clear();
+    for (const HeaderTU &TU : Headers) {
+      uint64_t Size = 0;
+      llvm::sys::fs::file_size(TU.Header, Size);
+      Work.push_back({TU.Header, Size});
+    }
+  }
+  size_t Total = Work.size();
+
+  // Translation units that cannot produce a diagnostic go first. This needs
+  // -checks to fix the set of enabled checks, i.e. to start with "-*".
+  std::optional<size_t> Skipped;
+  if (PreFilter) {
+    if (std::optional<std::vector<std::string>> Identifiers =
+            getTriggerIdentifiers(Checks)) {
+      size_t Before = Work.size();
+      Work = TokenPreFilter(std::move(*Identifiers))
+                 .filter(std::move(Work), *Database, Workers);
+      Skipped = Before - Work.size();
+    }
+  }
+
+  // Unchanged translation units are replayed before anything is scheduled,
+  // so neither preambles nor clang-tidy processes are spent on them
+  ResultMerger Merger;
+  std::optional<ResultCache> Cache;
+  if (!CacheDirectory.empty()) {
+    std::string Identity = getRunIdentity(*ClangTidy, Plugin);
+    std::error_code EC;
+    if (Identity.empty()) {
+      llvm::WithColor::warning() << "cannot hash clang-tidy or the plugin; "
+                                    "running without -cache-dir\n";
+    } else if ((EC = Cache.emplace(CacheDirectory, Identity).initialize())) {
+      llvm::WithColor::warning() << CacheDirectory << ": " << EC.message()
+                                 << "; running without -cache-dir\n";
+      Cache.reset();
+    } else {
+      Work = replayCachedResults(std::move(Work), *Database, *Cache, Merger,
+                                 Workers);
+      // Inherited by every clang-tidy process, which passes it to the plugin
+      ::setenv(kDependencyDirectoryEnv,
+               Cache->getDependencyDirectory().str().c_str(), 1);
+    }
+  }
+
+  // Peaks are recorded whenever there is somewhere to keep them, so the first
+  // run with a budget already has estimates
+  std::string HistoryPath = MemoryHistoryPath;
+  if (HistoryPath.empty() && Cache) {
+    llvm::SmallString<256> Path(CacheDirectory);
+    llvm::sys::path::append(Path, "peak-memory");
+    HistoryPath = std::string(Path);
+  }
+  std::optional<PeakMemoryHistory> History;
+  if (!HistoryPath.empty()) {
+    // An unreadable history is replaced at the end of the run
+    if (llvm::Error Err = History.emplace(HistoryPath).load()) {
+      llvm::WithColor::warning() << llvm::toString(std::move(Err)) << '\n';
+    }
+  }
+
+  if (Budget) {
+    // A process holds one AST at a time, so a batch needs as much as its
+    // largest TU. Unknown TUs are assumed to be as large as the largest known
+    // one. Without -batch-size, each TU gets its own process: its memory is
+    // returned as soon as its fixes are written, and its peak is recorded
+    // exactly rather than as a bound on its whole batch.
+    uint64_t Unknown = History ? History->getLargest() : 0;
+    if (!Unknown) {
+      Unknown = *Estimate;
+    }
+    for (TUJob &Job : Work) {
+      std::optional<uint64_t> Peak;
+      if (History) {
+        Peak = History->lookup(Job.File);
+      }
+      Job.PeakMemory = Peak ? *Peak : Unknown;
+    }
+    if (!BatchSize.getNumOccurrences()) {
+      BatchSize = 1;
+    }
+    if (!History) {
+      llvm::WithColor::warning()
+          << "no -memory-history or -cache-dir; every translation unit is "
+             "estimated at -memory-estimate\n";
+    }
+  }
+
+  // No point in more workers than batches
+  Workers = std::max<size_t>(
+      1, std::min<size_t>(Workers, (Work.size() + BatchSize - 1) /
+                                       std::max(1u, BatchSize.getValue())));
+
+  // Shared preambles are built before any batch runs
+  std::optional<PreambleStats> Preambles;
+  llvm::SmallString<256> PCHDirectory(PreambleDirectory);
+  bool RemovePCHDirectory = false;
+  if (SharePreambles) {
+    llvm::ErrorOr<std::string> Clang =
+        llvm::sys::findProgramByName(ClangBinary);
+    std::error_code EC;
+    if (!Clang) {
+      llvm::WithColor::warning() << "cannot find " << ClangBinary
+                                 << "; running without shared preambles\n";
+    } else if (PCHDirectory.empty()) {
+      EC = llvm::sys::fs::createUniqueDirectory("ttnn-tidy-pch", PCHDirectory);
+      RemovePCHDirectory = !EC;
+    } else {
+      EC = llvm::sys::fs::create_directories(PCHDirectory);
+    }
+    if (EC) {
+      llvm::WithColor::warning() << PCHDirectory << ": " << EC.message()
+                                 << "; running without shared preambles\n";
+    } else if (Clang) {
+      Preambles = buildSharedPreambles(Work, *Database, *Clang, PCHDirectory,
+                                       ExtraArgs, PreambleMinTUs, Workers);
+    }
+  }
+
+  BatchRunner Runner(*ClangTidy, Plugin, DatabaseDirectory, Merger,
+                     Cache ? &*Cache : nullptr, History ? &*History : nullptr);
+  Runner.Total = Work.size();
+  TUScheduler Scheduler(std::move(Work), Workers);
+
+  std::atomic<unsigned> Failures{0};
+  std::vector<std::thread> Threads;
+  for (unsigned Worker = 0; Worker != Workers; ++Worker) {
+    Threads.emplace_back([&, Worker] {
+      while (true) {
+        std::vector<TUJob> Batch = Scheduler.take(Worker, BatchSize);
+        if (Batch.empty()) {
+          return;
+        }
+        uint64_t Peak = 0;
+        if (Budget) {
+          for (const TUJob &Job : Batch) {
+            Peak = std::max(Peak, Job.PeakMemory);
+          }
+          Budget->acquire(Peak);
+        }
+        if (!Runner.run(Batch)) {
+          ++Failures;
+        }
+        if (Budget) {
+          Budget->release(Peak);
+        }
+      }
+    });
+  }
+  for (std::thread &T : Threads) {
+    T.join();
+  }
+  if (RemovePCHDirectory) {
+    llvm::sys::fs::remove_directories(PCHDirectory);
+  }
+  if (!HeaderDirectory.empty()) {
+    llvm::sys::fs::remove_directories(HeaderDirectory);
+  }
+
+  if (History) {
+    if (llvm::Error Err = History->save()) {
+      llvm::WithColor::warning() << llvm::toString(std::move(Err)) << '\n';
+    }
+  }
+
+  if (!ExportFixes.empty() && !Merger.write(ExportFixes)) {
+    return 1;
+  }
+  if (!ExportReplacements.empty() &&
+      !Merger.writeReplacements(ExportReplacements)) {
+    return 1;
+  }
+  llvm::errs() << Merger.size() << " diagnostics from " << Total
+               << " translation units\n";
+  if (Skipped) {
+    llvm::errs() << "pre-filter: " << *Skipped << "/" << Total
+                 << " translation units skipped\n";
+  }
+  if (Cache) {
+    llvm::errs() << "result cache: " << Cache->hits() << "/" << Total
+                 << " translation units replayed, " << Cache->stored()
+                 << " stored\n";
+  }
+  if (Preambles) {
+    Preambles->print(llvm::errs());
+  }
+  if (Budget) {
+    llvm::errs() << "memory budget: " << (Budget->getPeakProjected() >> 20)
+                 << "/" << (Budget->getLimit() >> 20)
+                 << " MiB projected at most, " << Budget->getWaits()
+                 << " batches waited for memory\n";
+  }
+  return Failures ? 1 : 0;
+}
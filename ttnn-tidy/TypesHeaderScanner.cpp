@@ -0,0 +1,332 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TypesHeaderScanner.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Lex/Lexer.h"
+#include "clang/Lex/Token.h"
+#include "common/TtNNNames.h"
+#include "common/TtNNSourceEdits.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+
+#include <algorithm>
+#include <optional>
+
+namespace clang::tidy::ttnn {
+
+namespace {
+
+LangOptions getLangOptions() {
+  LangOptions LO;
+  LO.CPlusPlus = true;
+  LO.CPlusPlus11 = true;
+  LO.CPlusPlus14 = true;
+  LO.CPlusPlus17 = true;
+  return LO;
+}
+
+bool isIdentifier(const Token &Tok, llvm::StringRef Name) {
+  return Tok.is(tok::raw_identifier) && Tok.getRawIdentifier() == Name;
+}
+
+/// Returns the tokens of the main file of \p SM, without comments and
+/// preprocessor directives.
+std::vector<Token> lexDeclarations(const SourceManager &SM,
+                                   const LangOptions &LO) {
+  FileID FID = SM.getMainFileID();
+  Lexer Lex(FID, SM.getBufferOrFake(FID), SM, LO);
+  std::vector<Token> Tokens;
+  bool InDirective = false;
+  while (true) {
+    Token Tok;
+    Lex.LexFromRawLexer(Tok);
+    if (Tok.is(tok::eof)) {
+      break;
+    }
+    // A directive ends at the first token on a new line; escaped newlines
+    // do not start one
+    if (Tok.isAtStartOfLine()) {
+      InDirective = Tok.is(tok::hash);
+    }
+    if (!InDirective) {
+      Tokens.push_back(Tok);
+    }
+  }
+  return Tokens;
+}
+
+/// Index just past the `]]` closing the attribute at \p I, or \p I if there
+/// is no attribute there.
+size_t skipAttribute(llvm::ArrayRef<Token> Tokens, size_t I) {
+  if (I + 1 >= Tokens.size() || !Tokens[I].is(tok::l_square) ||
+      !Tokens[I + 1].is(tok::l_square)) {
+    return I;
+  }
+  for (size_t J = I + 2; J + 1 < Tokens.size(); ++J) {
+    if (Tokens[J].is(tok::r_square) && Tokens[J + 1].is(tok::r_square)) {
+      return J + 2;
+    }
+  }
+  return I;
+}
+
+class HeaderScan {
+public:
+  HeaderScan(const SourceManager &SM, const LangOptions &LO,
+             const llvm::StringSet<> &CategoryNamespaces,
+             std::vector<tooling::Diagnostic> &Diagnostics)
+      : SM(SM), LO(LO), CategoryNamespaces(CategoryNamespaces),
+        Tokens(lexDeclarations(SM, LO)), Diagnostics(Diagnostics) {}
+
+  void run(bool ReturnValueTypeAlias, bool OperationTypeNaming) {
+    for (size_t I = 0, E = Tokens.size(); I != E; ++I) {
+      const Token &Tok = Tokens[I];
+      if (Tok.is(tok::l_brace)) {
+        Braces.push_back(0);
+        continue;
+      }
+      if (Tok.is(tok::r_brace)) {
+        if (!Braces.empty()) {
+          Namespaces.resize(Namespaces.size() - Braces.back());
+          Braces.pop_back();
+        }
+        continue;
+      }
+      if (!Tok.is(tok::raw_identifier)) {
+        continue;
+      }
+
+      llvm::StringRef Word = Tok.getRawIdentifier();
+      if (Word == "namespace") {
+        I = enterNamespace(I);
+      } else if (Word == "using" && ReturnValueTypeAlias) {
+        checkAlias(I);
+      } else if ((Word == "struct" || Word == "class") && OperationTypeNaming) {
+        checkStruct(I);
+      }
+    }
+  }
+
+private:
+  /// Handles `namespace a::b {` at \p I. Returns the index of the brace, or
+  /// \p I if this is not a namespace definition.
+  size_t enterNamespace(size_t I) {
+    llvm::SmallVector<llvm::StringRef, 4> Names;
+    size_t J = I + 1;
+    for (; J < Tokens.size(); ++J) {
+      if (Tokens[J].is(tok::raw_identifier)) {
+        if (Tokens[J].getRawIdentifier() != "inline") {
+          Names.push_back(Tokens[J].getRawIdentifier());
+        }
+      } else if (!Tokens[J].is(tok::coloncolon)) {
+        break;
+      }
+    }
+    // Aliases and using-directives have no body
+    if (J == Tokens.size() || !Tokens[J].is(tok::l_brace)) {
+      return I;
+    }
+    if (Names.empty()) {
+      Names.push_back(""); // anonymous
+    }
+    Namespaces.append(Names.begin(), Names.end());
+    Braces.push_back(Names.size());
+    return J;
+  }
+
+  /// Only declarations directly inside a namespace body are namespace-level
+  bool atNamespaceScope() const { return !Braces.empty() && Braces.back(); }
+
+  /// Same rule as ttnn-operation-type-naming: the innermost namespace that is
+  /// not a category, or else the innermost named one.
+  llvm::StringRef getOperationName() const {
+    for (llvm::StringRef Name : llvm::reverse(Namespaces)) {
+      if (!Name.empty() && !CategoryNamespaces.contains(Name)) {
+        return Name;
+      }
+    }
+    for (llvm::StringRef Name : llvm::reverse(Namespaces)) {
+      if (!Name.empty()) {
+        return Name;
+      }
+    }
+    return "";
+  }
+
+  /// `using spec_return_value_t = TensorSpec;` at \p I
+  void checkAlias(size_t I) {
+    if (!atNamespaceScope() || I + 4 >= Tokens.size() ||
+        (I > 0 && Tokens[I - 1].is(tok::greater))) {
+      return;
+    }
+    const Token &Name = Tokens[I + 1];
+    if (!(isIdentifier(Name, kSpecReturnValueT) ||
+          isIdentifier(Name, kTensorReturnValueT)) ||
+        !Tokens[I + 2].is(tok::equal)) {
+      return;
+    }
+
+    // The spellings ttnn-return-value-type-alias accepts: an optional
+    // `class`, an optional `ttnn::`, then Tensor or TensorSpec
+    size_t J = I + 3;
+    if (isIdentifier(Tokens[J], "class")) {
+      ++J;
+    }
+    if (J + 1 < Tokens.size() && isIdentifier(Tokens[J], "ttnn") &&
+        Tokens[J + 1].is(tok::coloncolon)) {
+      J += 2;
+    }
+    if (J + 1 >= Tokens.size() ||
+        !(isIdentifier(Tokens[J], "Tensor") ||
+          isIdentifier(Tokens[J], "TensorSpec")) ||
+        !Tokens[J + 1].is(tok::semi)) {
+      return;
+    }
+
+    llvm::StringRef AliasName = Name.getRawIdentifier();
+    report(kReturnValueTypeAliasCheckName, Name.getLocation(),
+           ("redundant type alias '" + AliasName + "'; remove from types file")
+               .str(),
+           removeDeclaration(
+               SourceRange(Tokens[I].getLocation(), Tokens[J].getLocation()),
+               SM, LO));
+  }
+
+  /// `struct operation_attributes_t {` at \p I
+  void checkStruct(size_t I) {
+    if (I > 0 && isIdentifier(Tokens[I - 1], "enum")) {
+      return;
+    }
+    size_t J = I + 1;
+    for (size_t Next; (Next = skipAttribute(Tokens, J)) != J;) {
+      J = Next;
+    }
+    if (J + 1 >= Tokens.size()) {
+      return;
+    }
+    const Token &Name = Tokens[J];
+    if (!(isIdentifier(Name, kOperationAttributesT) ||
+          isIdentifier(Name, kTensorArgsT))) {
+      return;
+    }
+    size_t K = J + 1;
+    if (isIdentifier(Tokens[K], "final") && K + 1 < Tokens.size()) {
+      ++K;
+    }
+    // Only definitions are renamed
+    if (!Tokens[K].is(tok::l_brace) && !Tokens[K].is(tok::colon)) {
+      return;
+    }
+
+    llvm::StringRef StructName = Name.getRawIdentifier();
+    llvm::StringRef OperationName = getOperationName();
+    if (OperationName.empty()) {
+      report(kOperationTypeNamingCheckName, Name.getLocation(),
+             ("generic type name '" + StructName +
+              "' should be renamed to an operation-specific name (e.g., "
+              "'{Operation}Params' or '{Operation}Inputs')")
+                 .str(),
+             std::nullopt);
+      return;
+    }
+
+    std::string SuggestedName = getSuggestedName(StructName, OperationName);
+    report(kOperationTypeNamingCheckName, Name.getLocation(),
+           ("generic type name '" + StructName + "' should be renamed to '" +
+            SuggestedName + "'")
+               .str(),
+           replaceToken(Name.getLocation(), StructName, SuggestedName, SM, LO));
+  }
+
+  void report(llvm::StringRef Check, SourceLocation Loc,
+              const std::string &Message,
+              const std::optional<FixItHint> &Fix) {
+    tooling::DiagnosticMessage Main(Message, SM, Loc);
+    if (Fix) {
+      tooling::Replacement R(SM, Fix->RemoveRange, Fix->CodeToInsert, LO);
+      llvm::consumeError(Main.Fix[R.getFilePath()].add(R));
+    }
+    Diagnostics.emplace_back(Check, Main,
+                             llvm::SmallVector<tooling::DiagnosticMessage, 1>(),
+                             tooling::Diagnostic::Warning,
+                             /*BuildDirectory=*/"");
+  }
+
+  const SourceManager &SM;
+  const LangOptions &LO;
+  const llvm::StringSet<> &CategoryNamespaces;
+  std::vector<Token> Tokens;
+  std::vector<tooling::Diagnostic> &Diagnostics;
+
+  // Names of the enclosing namespaces, outermost first, and for each open
+  // brace the number of names its namespace definition added
+  llvm::SmallVector<llvm::StringRef, 8> Namespaces;
+  llvm::SmallVector<unsigned, 16> Braces;
+};
+
+} // namespace
+
+std::vector<std::string> findTypesHeaders(llvm::ArrayRef<std::string> Inputs) {
+  std::vector<std::string> Headers;
+  auto Add = [&](llvm::StringRef Path) {
+    llvm::SmallString<256> Absolute(Path);
+    llvm::sys::fs::make_absolute(Absolute);
+    llvm::sys::path::remove_dots(Absolute, /*remove_dot_dot=*/true);
+    Headers.push_back(std::string(Absolute));
+  };
+
+  for (const std::string &Input : Inputs) {
+    if (!llvm::sys::fs::is_directory(Input)) {
+      if (isTypesFile(Input)) {
+        Add(Input);
+      }
+      continue;
+    }
+    std::error_code EC;
+    for (llvm::sys::fs::recursive_directory_iterator It(Input, EC), End;
+         It != End && !EC; It.increment(EC)) {
+      if (isTypesFile(It->path())) {
+        Add(It->path());
+      }
+    }
+  }
+
+  llvm::sort(Headers);
+  Headers.erase(std::unique(Headers.begin(), Headers.end()), Headers.end());
+  return Headers;
+}
+
+TypesHeaderScanner::TypesHeaderScanner(bool ReturnValueTypeAlias,
+                                       bool OperationTypeNaming,
+                                       llvm::StringRef Categories)
+    : ReturnValueTypeAlias(ReturnValueTypeAlias),
+      OperationTypeNaming(OperationTypeNaming) {
+  llvm::SmallVector<llvm::StringRef, 32> Namespaces;
+  Categories.split(Namespaces, ';', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+  for (llvm::StringRef Namespace : Namespaces) {
+    CategoryNamespaces.insert(Namespace.trim());
+  }
+}
+
+std::vector<tooling::Diagnostic>
+TypesHeaderScanner::scan(llvm::StringRef Path, llvm::StringRef Content) const {
+  std::vector<tooling::Diagnostic> Diagnostics;
+  if (!ReturnValueTypeAlias && !OperationTypeNaming) {
+    return Diagnostics;
+  }
+
+  // The fixes are built by the same code as the checks', so they only need
+  // a source manager over this one file
+  SourceManagerForFile File(Path, Content);
+  LangOptions LO = getLangOptions();
+  HeaderScan(File.get(), LO, CategoryNamespaces, Diagnostics)
+      .run(ReturnValueTypeAlias, OperationTypeNaming);
+  return Diagnostics;
+}
+
+} // namespace clang::tidy::ttnn
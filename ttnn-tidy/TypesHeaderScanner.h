@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_TYPESHEADERSCANNER_H_
+#define TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_TYPESHEADERSCANNER_H_
+
+#include "clang/Tooling/Core/Diagnostic.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
+
+#include <string>
+#include <vector>
+
+namespace clang::tidy::ttnn {
+
+/// Returns the `*_device_operation_types.hpp` headers among \p Inputs, with
+/// directories searched recursively, as sorted absolute paths.
+std::vector<std::string> findTypesHeaders(llvm::ArrayRef<std::string> Inputs);
+
+/// Checks the declarations in a types header with the raw lexer alone.
+///
+/// Inside `*_device_operation_types.hpp` files, the declaration-side parts of
+/// the return-alias and naming checks only depend on how the declarations are
+/// spelled, so they need neither a compile command nor a parse:
+///
+///   - namespace-level `using spec_return_value_t = TensorSpec;` and
+///     `using tensor_return_value_t = Tensor;` (ttnn-return-value-type-alias);
+///   - `struct operation_attributes_t {` and `struct tensor_args_t {`
+///     definitions, renamed after the enclosing operation namespace
+///     (ttnn-operation-type-naming).
+///
+/// The diagnostics and fixes are the ones the checks report for the same
+/// declarations. Preprocessor directives are skipped and macros are not
+/// expanded, so declarations produced by macros are not seen, and those in
+/// every `#if` branch are.
+class TypesHeaderScanner {
+public:
+  /// Runs the enabled checks; operations are named after the innermost
+  /// namespace not in the semicolon-separated \p Categories.
+  TypesHeaderScanner(bool ReturnValueTypeAlias, bool OperationTypeNaming,
+                     llvm::StringRef Categories);
+
+  /// Returns the diagnostics for the header \p Path with contents
+  /// \p Content.
+  std::vector<tooling::Diagnostic> scan(llvm::StringRef Path,
+                                        llvm::StringRef Content) const;
+
+private:
+  bool ReturnValueTypeAlias;
+  bool OperationTypeNaming;
+  llvm::StringSet<> CategoryNamespaces;
+};
+
+} // namespace clang::tidy::ttnn
+
+#endif // TTOOLS_CLANG_TIDY_PLUGINS_TTNN_TIDY_TYPESHEADERSCANNER_H_